@@ -0,0 +1,279 @@
+/*
+ * Headless AI battle benchmark.
+ *
+ * Loads each map and fights a fixed sequence of battles between random
+ * armies, a player army and neutral monsters, both under AI control and
+ * without the battle interface. Prints the latency percentiles of a battle
+ * turn (one Arena::Turns call, every unit acts once) and a checksum of the
+ * battle results; the checksums can be stored in a golden file to check that
+ * optimisations keep the battles identical. With -j the battles run as one
+ * Battle::Simulator batch on that many threads and the throughput is printed;
+ * every battle has its own seed, so the checksum does not depend on -j.
+ * With -e each battle is first estimated by the adventure AI's
+ * Battle::Estimator with an empty cache, and the cost of an estimate is
+ * printed: its fixed battle count is the only bound on it by default.
+ *
+ * usage: fheroes2_battlebench [-n battles] [-s seed] [-j threads] [-e] [-g golden] [-u] maps...
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
+#include "bench_common.h"
+#include "army.h"
+#include "battle_arena.h"
+#include "battle_estimator.h"
+#include "battle_simulator.h"
+#include "system.h"
+
+namespace
+{
+    // stalemates are cut after this many turns
+    const uint32_t maxTurns = 100;
+
+    struct BenchResult
+    {
+        BenchResult() : batch(0), turns(0), unfinished(0)
+        {}
+
+        vector<double> latency;   // microseconds
+        vector<double> estimates; // milliseconds
+        double batch;             // seconds
+        uint32_t turns;
+        uint32_t unfinished;
+        Bench::Checksum checksum;
+    };
+
+    void RandomArmy(Army &army, Bench::Random &rnd)
+    {
+        const uint32_t troops = 1 + rnd.Get(ARMYMAXTROOPS);
+
+        for (uint32_t ii = 0; ii < troops; ++ii)
+            army.m_troops.JoinTroop(Monster(Monster::PEASANT + rnd.Get(Monster::WATER_ELEMENT)), 1 + rnd.Get(50));
+    }
+
+    void RunBattle(Battle::SimulatorJob &job, BenchResult &result)
+    {
+        Battle::Arena arena(*job.army1, *job.army2, job.mapsindex, false, job.seed);
+
+        while (arena.BattleValid() && arena.GetCurrentTurn() < maxTurns)
+        {
+            const auto start = std::chrono::steady_clock::now();
+            arena.Turns();
+            const auto stop = std::chrono::steady_clock::now();
+
+            result.latency.push_back(std::chrono::duration<double, std::micro>(stop - start).count());
+        }
+
+        job.result = arena.GetResult();
+        job.turns = arena.GetCurrentTurn();
+    }
+
+    /* a cache miss of the estimator for every battle, the armies stay as they are */
+    void RunEstimates(const vector<Battle::SimulatorJob> &jobs, BenchResult &result)
+    {
+        for (const auto &job : jobs)
+        {
+            Battle::Estimator::ClearCache();
+
+            const auto start = std::chrono::steady_clock::now();
+            Battle::Estimator().Get(*job.army1, *job.army2, job.mapsindex);
+            const auto stop = std::chrono::steady_clock::now();
+
+            result.estimates.push_back(std::chrono::duration<double, std::milli>(stop - start).count());
+        }
+
+        Battle::Estimator::ClearCache();
+        sort(result.estimates.begin(), result.estimates.end());
+    }
+
+    bool RunMap(const string &file, uint32_t battles, uint32_t seed, int threads, bool estimates,
+                BenchResult &result)
+    {
+        const Settings &conf = Settings::Get();
+
+        if (!Bench::LoadMap(file, seed))
+            return false;
+
+        MapsIndexes land;
+
+        for (const auto &tile : world.vec_tiles)
+            if (Bench::IsStartTile(tile) && !tile.isWater())
+                land.push_back(tile.GetIndex());
+
+        const int color = Color::GetFirst(conf.GetPlayers().GetColors());
+        sp<Player> player = Players::Get(color);
+
+        if (land.empty() || !player)
+            return false;
+
+        player->SetControl(CONTROL_AI);
+
+        Bench::Random rnd(seed);
+        vector<up<Army>> armies;
+        vector<Battle::SimulatorJob> jobs;
+
+        armies.reserve(2 * battles);
+        jobs.reserve(battles);
+
+        for (uint32_t ii = 0; ii < battles; ++ii)
+        {
+            armies.emplace_back(new Army());
+            Army &army1 = *armies.back();
+            armies.emplace_back(new Army());
+            Army &army2 = *armies.back();
+
+            army1.SetColor(color);
+            RandomArmy(army1, rnd);
+            RandomArmy(army2, rnd);
+
+            jobs.emplace_back(army1, army2, land[rnd.Get(land.size())], seed + ii);
+        }
+
+        if (estimates)
+            RunEstimates(jobs, result);
+
+        if (0 <= threads)
+        {
+            const auto start = std::chrono::steady_clock::now();
+            Battle::Simulator(maxTurns).RunBatch(jobs, threads);
+            const auto stop = std::chrono::steady_clock::now();
+
+            result.batch = std::chrono::duration<double>(stop - start).count();
+        } else
+        {
+            for (auto &job : jobs)
+                RunBattle(job, result);
+        }
+
+        for (uint32_t ii = 0; ii < battles; ++ii)
+        {
+            const Battle::SimulatorJob &job = jobs[ii];
+
+            result.turns += job.turns;
+            if (!(job.result.army1 | job.result.army2)) ++result.unfinished;
+
+            result.checksum.Hash(ii);
+            result.checksum.Hash(job.turns);
+            result.checksum.Hash(job.result.army1);
+            result.checksum.Hash(job.result.army2);
+            result.checksum.Hash(job.result.killed);
+        }
+
+        sort(result.latency.begin(), result.latency.end());
+        return true;
+    }
+
+    int PrintHelp(const char *basename)
+    {
+        COUT("Usage: " << basename << " [-n battles] [-s seed] [-j threads] [-e] [-g golden] [-u] maps...");
+        COUT("  -n\tbattles per map, default 200");
+        COUT("  -s\trandom seed, default 1");
+        COUT("  -j\tsimulator threads, 0 for one per core; default: timed turns on this thread");
+        COUT("  -e\talso time an uncached battle estimate for every battle");
+        COUT("  -g\tgolden checksums file to compare with");
+        COUT("  -u\trewrite the golden file instead of comparing");
+        return EXIT_SUCCESS;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t battles = 200;
+    uint32_t seed = 1;
+    int threads = -1;
+    string golden_file;
+    bool update = false;
+    bool estimates = false;
+    vector<string> maps;
+
+    for (int ii = 1; ii < argc; ++ii)
+    {
+        const string arg(argv[ii]);
+
+        if (arg == "-n" && ii + 1 < argc)
+            battles = GetInt(argv[++ii]);
+        else if (arg == "-s" && ii + 1 < argc)
+            seed = GetInt(argv[++ii]);
+        else if (arg == "-j" && ii + 1 < argc)
+            threads = GetInt(argv[++ii]);
+        else if (arg == "-g" && ii + 1 < argc)
+            golden_file = argv[++ii];
+        else if (arg == "-u")
+            update = true;
+        else if (arg == "-e")
+            estimates = true;
+        else if (arg == "-h")
+            return PrintHelp(argv[0]);
+        else
+            maps.push_back(arg);
+    }
+
+    if (maps.empty())
+        return PrintHelp(argv[0]);
+
+    Settings::Get().SetProgramPath(argv[0]);
+
+    map<string, string> golden = golden_file.empty() ? map<string, string>() : Bench::ReadGolden(golden_file);
+    bool mismatch = false;
+
+    for (const auto &file : maps)
+    {
+        const string name = System::GetBasename(file);
+        BenchResult result;
+
+        if (!RunMap(file, battles, seed, threads, estimates, result))
+        {
+            ERROR("cannot run map: " << file);
+            mismatch = true;
+            continue;
+        }
+
+        const string checksum = result.checksum.String();
+
+        if (0 <= threads)
+        {
+            COUT(name << ": battles: " << battles << ", turns: " << result.turns <<
+                 ", unfinished: " << result.unfinished <<
+                 ", total ms: " << result.batch * 1000 <<
+                 ", battles/s: " << battles / max(result.batch, 1e-9) <<
+                 ", checksum: " << checksum);
+        } else
+        {
+            double total = 0;
+            for (double value : result.latency)
+                total += value;
+
+            COUT(name << ": battles: " << battles << ", turns: " << result.turns <<
+                 ", unfinished: " << result.unfinished <<
+                 ", total ms: " << total / 1000 <<
+                 ", turn p50 us: " << Bench::Percentile(result.latency, 0.5) <<
+                 ", p90 us: " << Bench::Percentile(result.latency, 0.9) <<
+                 ", p99 us: " << Bench::Percentile(result.latency, 0.99) <<
+                 ", max us: " << Bench::Percentile(result.latency, 1.0) <<
+                 ", checksum: " << checksum);
+        }
+
+        if (estimates)
+        {
+            COUT(name << ": estimates: " << result.estimates.size() <<
+                 ", estimate p50 ms: " << Bench::Percentile(result.estimates, 0.5) <<
+                 ", p99 ms: " << Bench::Percentile(result.estimates, 0.99) <<
+                 ", max ms: " << Bench::Percentile(result.estimates, 1.0));
+        }
+
+        if (!golden_file.empty() && !update && golden.count(name) && golden[name] != checksum)
+        {
+            ERROR(name << ": battles differ from golden checksum " << golden[name]);
+            mismatch = true;
+        }
+
+        golden[name] = checksum;
+    }
+
+    if (update && !golden_file.empty())
+        Bench::WriteGolden(golden_file, golden);
+
+    return mismatch ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,431 @@
+/*
+ * Headless battle scenario benchmark.
+ *
+ * Loads each map and fights a catalogue of canned battles without the
+ * battle interface, each many times with fixed seeds:
+ *   skirmish - two small armies in the open field, no commanders;
+ *   siege    - full armies, a hero with a catapult against castle walls;
+ *   spells   - two heroes with every combat spell and full spell points.
+ * Before every battle turn each living unit asks AI::BattleTurn for a
+ * decision that is timed and thrown away, so the AI cost is reported apart
+ * from Arena::Turns, and so is a capture of the battle state the search AI
+ * starts from. The first finished battle of every scenario is also
+ * recorded and played back, the AI decides on both sides so a replay that
+ * leaves the arena random stream fails the run. Prints turns per second,
+ * battle path queries per turn,
+ * the AI decision and state capture latency and a checksum of the results per scenario; the
+ * checksums can be stored in a golden file like the other benchmarks.
+ *
+ * usage: fheroes2_battlescenariobench [-n battles] [-s seed] [-b ms] [-g golden] [-u] maps...
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
+#include "bench_common.h"
+#include "ai.h"
+#include "army.h"
+#include "castle.h"
+#include "heroes.h"
+#include "battle_arena.h"
+#include "battle_army.h"
+#include "battle_board.h"
+#include "battle_command.h"
+#include "battle_replay.h"
+#include "battle_state.h"
+#include "battle_troop.h"
+#include "system.h"
+
+namespace
+{
+    // stalemates are cut after this many turns
+    const uint32_t maxTurns = 100;
+
+    enum
+    {
+        SKIRMISH, SIEGE, SPELLS, SCENARIOS
+    };
+
+    const char *scenarioNames[] = {"skirmish", "siege", "spells"};
+
+    struct BenchResult
+    {
+        BenchResult() : battles(0), turns(0), unfinished(0), paths(0), seconds(0)
+        {}
+
+        vector<double> decisions; // microseconds
+        vector<double> captures;  // nanoseconds
+        uint32_t battles;
+        uint32_t turns;
+        uint32_t unfinished;
+        uint64_t paths;
+        double seconds;           // in Arena::Turns
+        Bench::Checksum checksum;
+    };
+
+    /* what the scenarios need from the map */
+    struct MapSetup
+    {
+        MapSetup() : color1(Color::NONE), color2(Color::NONE), hero1(nullptr), hero2(nullptr), castle(nullptr),
+                     field(-1)
+        {}
+
+        int color1;
+        int color2;
+        Heroes *hero1;
+        Heroes *hero2;
+        const Castle *castle;
+        s32 field;
+    };
+
+    void RandomArmy(Army &army, Bench::Random &rnd, uint32_t troops, uint32_t count)
+    {
+        for (uint32_t ii = 0; ii < troops; ++ii)
+            army.m_troops.JoinTroop(Monster(Monster::PEASANT + rnd.Get(Monster::WATER_ELEMENT)), 1 + rnd.Get(count));
+    }
+
+    /* a hero with every combat spell, spell points back to full before each battle */
+    void PrepareCaster(Heroes &hero)
+    {
+        hero.SpellBookActivate();
+
+        for (int id = Spell::FIREBALL; id < Spell::RANDOM; ++id)
+            if (Spell(id).isCombat())
+                hero.AppendSpellToBook(Spell(id), true);
+    }
+
+    void ResetCommander(Heroes *hero)
+    {
+        if (!hero) return;
+
+        hero->SetSpellPoints(100);
+        hero->ResetModes(Heroes::SPELLCASTED);
+    }
+
+    /* false if the map has nothing for the scenario */
+    bool BuildScenario(int scenario, const MapSetup &setup, Bench::Random &rnd, Army &army1, Army &army2, s32 &index)
+    {
+        army1.SetColor(setup.color1);
+
+        switch (scenario)
+        {
+            case SKIRMISH:
+                RandomArmy(army1, rnd, 2, 20);
+                RandomArmy(army2, rnd, 2, 20);
+                index = setup.field;
+                return true;
+
+            case SIEGE:
+                if (!setup.castle || !setup.hero1) return false;
+                ResetCommander(setup.hero1);
+                army1.SetCommander(setup.hero1);
+                army2.SetColor(setup.castle->GetColor());
+                RandomArmy(army1, rnd, ARMYMAXTROOPS, 60);
+                RandomArmy(army2, rnd, ARMYMAXTROOPS, 60);
+                index = setup.castle->GetIndex();
+                return true;
+
+            case SPELLS:
+                if (!setup.hero1 || !setup.hero2) return false;
+                ResetCommander(setup.hero1);
+                ResetCommander(setup.hero2);
+                army1.SetCommander(setup.hero1);
+                army2.SetCommander(setup.hero2);
+                army2.SetColor(setup.color2);
+                RandomArmy(army1, rnd, 3, 30);
+                RandomArmy(army2, rnd, 3, 30);
+                index = setup.field;
+                return true;
+
+            default:
+                break;
+        }
+
+        return false;
+    }
+
+    /* the decision of every living unit, timed and dropped; the arena random streams stay untouched */
+    void ProbeDecisions(Battle::Arena &arena, BenchResult &result)
+    {
+        const Rand::Stream random = Battle::Arena::GetRandom();
+        const Rand::Stream ai_random = Battle::Arena::GetAIRandom();
+        const Battle::Force *forces[] = {&arena.GetForce1(), &arena.GetForce2()};
+
+        for (const Battle::Force *force : forces)
+            for (const Battle::Unit *unit : *force)
+            {
+                if (!unit->isValid()) continue;
+
+                Battle::Actions actions;
+
+                const auto start = std::chrono::steady_clock::now();
+                AI::BattleTurn(arena, *unit, actions);
+                const auto stop = std::chrono::steady_clock::now();
+
+                result.decisions.push_back(std::chrono::duration<double, std::micro>(stop - start).count());
+            }
+
+        Battle::Arena::GetRandom() = random;
+        Battle::Arena::GetAIRandom() = ai_random;
+    }
+
+    /* the state the search AI starts from, timed and dropped */
+    void ProbeCapture(const Battle::Arena &arena, BenchResult &result)
+    {
+        Battle::State state;
+
+        const auto start = std::chrono::steady_clock::now();
+        state.Capture(arena);
+        const auto stop = std::chrono::steady_clock::now();
+
+        result.captures.push_back(std::chrono::duration<double, std::nano>(stop - start).count());
+    }
+
+    /* true if the battle was recorded to the file */
+    bool RunBattle(Army &army1, Army &army2, s32 index, uint32_t seed, BenchResult &result, const string &record)
+    {
+        Battle::Arena arena(army1, army2, index, false, seed);
+        Battle::Replay replay;
+
+        if (!record.empty())
+        {
+            replay.Start(army1, army2, index, seed);
+            arena.SetReplay(&replay);
+        }
+
+        while (arena.BattleValid() && arena.GetCurrentTurn() < maxTurns)
+        {
+            ProbeCapture(arena, result);
+            ProbeDecisions(arena, result);
+
+            const uint32_t paths = Battle::Board::GetAStarQueries();
+            const auto start = std::chrono::steady_clock::now();
+            arena.Turns();
+            const auto stop = std::chrono::steady_clock::now();
+
+            result.seconds += std::chrono::duration<double>(stop - start).count();
+            result.paths += Battle::Board::GetAStarQueries() - paths;
+        }
+
+        const Battle::Result &res = arena.GetResult();
+
+        result.turns += arena.GetCurrentTurn();
+        if (!(res.army1 | res.army2)) ++result.unfinished;
+
+        result.checksum.Hash(seed);
+        result.checksum.Hash(arena.GetCurrentTurn());
+        result.checksum.Hash(res.army1);
+        result.checksum.Hash(res.army2);
+        result.checksum.Hash(res.killed);
+        result.checksum.Hash(army1.m_troops.GetStrength());
+        result.checksum.Hash(army2.m_troops.GetStrength());
+
+        // a battle cut at maxTurns has no end to compare with
+        if (record.empty() || !(res.army1 | res.army2))
+            return false;
+
+        replay.Finish(res, arena.GetCurrentTurn());
+        return replay.Save(record);
+    }
+
+    /* the recorded battle played back without the AI gives the same result */
+    bool CheckReplay(const string &record, const MapSetup &setup)
+    {
+        ResetCommander(setup.hero1);
+        ResetCommander(setup.hero2);
+
+        const bool same = Battle::PlayReplay(record, false, false);
+        System::Unlink(record);
+
+        return same;
+    }
+
+    bool SetupMap(const string &file, uint32_t seed, MapSetup &setup)
+    {
+        const Settings &conf = Settings::Get();
+
+        if (!Bench::LoadMap(file, seed))
+            return false;
+
+        MapsIndexes land;
+
+        for (const auto &tile : world.vec_tiles)
+            if (Bench::IsStartTile(tile) && !tile.isWater())
+                land.push_back(tile.GetIndex());
+
+        const Colors colors(conf.GetPlayers().GetColors());
+
+        if (land.size() < 2 || colors.empty())
+            return false;
+
+        for (int color : colors)
+        {
+            sp<Player> player = Players::Get(color);
+            if (player) player->SetControl(CONTROL_AI);
+        }
+
+        setup.color1 = colors[0];
+        setup.color2 = 1 < colors.size() ? colors[1] : Color::NONE;
+        setup.field = land.front();
+
+        // the commanders wait at the map start tiles
+        setup.hero1 = world.GetFreemanHeroes();
+        if (setup.hero1 && !setup.hero1->Recruit(setup.color1, Maps::GetPoint(land[0])))
+            setup.hero1 = nullptr;
+
+        setup.hero2 = Color::NONE != setup.color2 ? world.GetFreemanHeroes() : nullptr;
+        if (setup.hero2 && !setup.hero2->Recruit(setup.color2, Maps::GetPoint(land[1])))
+            setup.hero2 = nullptr;
+
+        if (setup.hero1) PrepareCaster(*setup.hero1);
+        if (setup.hero2) PrepareCaster(*setup.hero2);
+
+        for (const Castle *castle : world.vec_castles)
+            if (castle->isCastle() && castle->GetColor() != setup.color1)
+            {
+                setup.castle = castle;
+                break;
+            }
+
+        return true;
+    }
+
+    /* false if the replay of a battle differs */
+    bool RunScenario(int scenario, const MapSetup &setup, uint32_t battles, uint32_t seed, BenchResult &result)
+    {
+        Bench::Random rnd(seed + scenario);
+        const string record = string("battlescenariobench_") + scenarioNames[scenario] + ".rpl";
+        bool replayed = false;
+        bool same = true;
+
+        for (uint32_t ii = 0; ii < battles; ++ii)
+        {
+            Army army1;
+            Army army2;
+            s32 index = -1;
+
+            if (!BuildScenario(scenario, setup, rnd, army1, army2, index))
+                return same;
+
+            if (RunBattle(army1, army2, index, seed + ii, result, replayed ? string() : record))
+            {
+                same = CheckReplay(record, setup);
+                replayed = true;
+            }
+
+            ++result.battles;
+        }
+
+        sort(result.decisions.begin(), result.decisions.end());
+        sort(result.captures.begin(), result.captures.end());
+        return same;
+    }
+
+    int PrintHelp(const char *basename)
+    {
+        COUT("Usage: " << basename << " [-n battles] [-s seed] [-b ms] [-g golden] [-u] maps...");
+        COUT("  -n\tbattles per scenario, default 50");
+        COUT("  -s\trandom seed, default 1");
+        COUT("  -b\tsearch battle AI budget in ms, default 0: simple AI; the checksums then vary");
+        COUT("  -g\tgolden checksums file to compare with");
+        COUT("  -u\trewrite the golden file instead of comparing");
+        return EXIT_SUCCESS;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t battles = 50;
+    uint32_t seed = 1;
+    uint32_t budget = 0;
+    string golden_file;
+    bool update = false;
+    vector<string> maps;
+
+    for (int ii = 1; ii < argc; ++ii)
+    {
+        const string arg(argv[ii]);
+
+        if (arg == "-n" && ii + 1 < argc)
+            battles = GetInt(argv[++ii]);
+        else if (arg == "-s" && ii + 1 < argc)
+            seed = GetInt(argv[++ii]);
+        else if (arg == "-b" && ii + 1 < argc)
+            budget = GetInt(argv[++ii]);
+        else if (arg == "-g" && ii + 1 < argc)
+            golden_file = argv[++ii];
+        else if (arg == "-u")
+            update = true;
+        else if (arg == "-h")
+            return PrintHelp(argv[0]);
+        else
+            maps.push_back(arg);
+    }
+
+    if (maps.empty())
+        return PrintHelp(argv[0]);
+
+    Settings::Get().SetProgramPath(argv[0]);
+    Settings::Get().SetBattleAIBudget(budget);
+
+    map<string, string> golden = golden_file.empty() ? map<string, string>() : Bench::ReadGolden(golden_file);
+    bool mismatch = false;
+
+    for (const auto &file : maps)
+    {
+        const string basename = System::GetBasename(file);
+
+        for (int scenario = 0; scenario < SCENARIOS; ++scenario)
+        {
+            // every scenario starts from a freshly loaded map
+            MapSetup setup;
+
+            if (!SetupMap(file, seed, setup))
+            {
+                ERROR("cannot run map: " << file);
+                mismatch = true;
+                break;
+            }
+
+            const string name = basename + ":" + scenarioNames[scenario];
+            BenchResult result;
+
+            if (!RunScenario(scenario, setup, battles, seed, result))
+            {
+                ERROR(name << ": battle replay differs from the recorded battle");
+                mismatch = true;
+            }
+
+            if (!result.battles)
+            {
+                COUT(name << ": skipped, the map has no place for it");
+                continue;
+            }
+
+            const string checksum = result.checksum.String();
+
+            COUT(name << ": battles: " << result.battles << ", turns: " << result.turns <<
+                 ", unfinished: " << result.unfinished <<
+                 ", turns/s: " << result.turns / max(result.seconds, 1e-9) <<
+                 ", paths/turn: " << static_cast<double>(result.paths) / max<uint32_t>(result.turns, 1) <<
+                 ", decision p50 us: " << Bench::Percentile(result.decisions, 0.5) <<
+                 ", p99 us: " << Bench::Percentile(result.decisions, 0.99) <<
+                 ", capture p50 ns: " << Bench::Percentile(result.captures, 0.5) <<
+                 ", checksum: " << checksum);
+
+            if (!golden_file.empty() && !update && golden.count(name) && golden[name] != checksum)
+            {
+                ERROR(name << ": battles differ from golden checksum " << golden[name]);
+                mismatch = true;
+            }
+
+            golden[name] = checksum;
+        }
+    }
+
+    if (update && !golden_file.empty())
+        Bench::WriteGolden(golden_file, golden);
+
+    return mismatch ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,75 @@
+/*
+ * Helpers shared by the headless benchmarks: a portable random sequence,
+ * result checksums, latency percentiles, golden files and map loading.
+ */
+
+#pragma once
+
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "settings.h"
+#include "world.h"
+#include "game_headless.h"
+
+namespace Bench
+{
+    /* the same sequence on every platform, unlike rand() */
+    struct Random
+    {
+        explicit Random(uint32_t seed) : state(seed)
+        {}
+
+        uint32_t Get(uint32_t size)
+        {
+            state = state * 1664525 + 1013904223;
+            return size ? (state >> 8) % size : 0;
+        }
+
+        uint32_t state;
+    };
+
+    using Game::Headless::Checksum;
+
+    inline double Percentile(const vector<double> &sorted, double part)
+    {
+        return sorted.empty() ? 0 : sorted[static_cast<size_t>(part * (sorted.size() - 1))];
+    }
+
+    inline map<string, string> ReadGolden(const string &file)
+    {
+        map<string, string> golden;
+        ifstream fs(file.c_str());
+        string name;
+        string checksum;
+
+        while (fs >> name >> checksum)
+            golden[name] = checksum;
+
+        return golden;
+    }
+
+    inline void WriteGolden(const string &file, const map<string, string> &golden)
+    {
+        ofstream fs(file.c_str());
+        for (const auto &it : golden)
+            fs << it.first << " " << it.second << endl;
+    }
+
+    /* load the map as a new game, without a current color */
+    inline bool LoadMap(const string &file, uint32_t seed)
+    {
+        // map generation uses the global generator
+        srand(seed);
+
+        return Game::Headless::LoadMap(file);
+    }
+
+    inline bool IsStartTile(const Maps::Tiles &tile)
+    {
+        return MP2::OBJ_ZERO == tile.GetObject() && DIRECTION_ALL == tile.GetPassable();
+    }
+}
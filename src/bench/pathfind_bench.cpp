@@ -0,0 +1,200 @@
+/*
+ * Headless adventure pathfinding benchmark.
+ *
+ * Loads each map, recruits one hero and runs a fixed sequence of route
+ * queries with every pathfinding level, on land and on boat. Prints the map
+ * load time and addons pool size, latency percentiles, node expansions and a
+ * checksum of all found routes; the checksums can be stored in a golden file
+ * to check that optimisations keep the routes identical.
+ *
+ * usage: fheroes2_pathbench [-n queries] [-s seed] [-g golden] [-u] maps...
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
+#include "bench_common.h"
+#include "heroes.h"
+#include "route.h"
+#include "system.h"
+
+namespace
+{
+    struct BenchResult
+    {
+        BenchResult() : load(0), addons(0), found(0), expanded(0)
+        {}
+
+        double load;            // milliseconds
+        size_t addons;          // bytes of the addons pool
+        vector<double> latency; // microseconds
+        uint32_t found;
+        uint64_t expanded;
+        Bench::Checksum checksum;
+    };
+
+    void SetPathfinding(Heroes &hero, int level)
+    {
+        Skill::Secondary *skill = hero.GetSecondarySkills().FindSkill(Skill::Secondary::PATHFINDING);
+
+        if (skill)
+            skill->SetLevel(level);
+        else if (level)
+            hero.LearnSkill(Skill::Secondary(Skill::Secondary::PATHFINDING, level));
+    }
+
+    bool RunMap(const string &file, uint32_t queries, uint32_t seed, BenchResult &result)
+    {
+        const Settings &conf = Settings::Get();
+
+        const auto load = std::chrono::steady_clock::now();
+
+        if (!Bench::LoadMap(file, seed))
+            return false;
+
+        result.load = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - load).count();
+        result.addons = world.addons_pool.items.capacity() * sizeof(Maps::TilesAddon);
+
+        MapsIndexes land;
+        MapsIndexes water;
+
+        for (const auto &tile : world.vec_tiles)
+            if (Bench::IsStartTile(tile))
+                (tile.isWater() ? water : land).push_back(tile.GetIndex());
+
+        const int color = Color::GetFirst(conf.GetPlayers().GetColors());
+        Heroes *hero = world.GetFreemanHeroes();
+
+        if (land.empty() || !hero || !hero->Recruit(color, Maps::GetPoint(land.front())))
+            return false;
+
+        Bench::Random rnd(seed);
+        result.latency.reserve(queries);
+
+        for (uint32_t ii = 0; ii < queries; ++ii)
+        {
+            // every fourth query sails, every eighth target is anywhere on the map
+            const bool boat = 3 == ii % 4 && !water.empty();
+            const MapsIndexes &starts = boat ? water : land;
+            const s32 from = starts[rnd.Get(starts.size())];
+            const s32 to = 7 == ii % 8 ? static_cast<s32>(rnd.Get(world.vec_tiles.size()))
+                                       : starts[rnd.Get(starts.size())];
+
+            hero->Move2Dest(from, true);
+            hero->SetShipMaster(boat);
+            SetPathfinding(*hero, ii % 4);
+
+            Route::Path &path = hero->GetPath();
+            path.Reset();
+
+            const auto start = std::chrono::steady_clock::now();
+            const bool valid = path.Calculate(to);
+            const auto stop = std::chrono::steady_clock::now();
+
+            result.latency.push_back(std::chrono::duration<double, std::micro>(stop - start).count());
+            result.expanded += Route::Path::GetLastExpanded();
+
+            result.checksum.Hash(ii);
+            result.checksum.Hash(valid);
+            if (valid) ++result.found;
+
+            for (const auto &step : path)
+            {
+                result.checksum.Hash(step.GetFrom());
+                result.checksum.Hash(step.GetDirection());
+                result.checksum.Hash(step.GetPenalty());
+            }
+        }
+
+        sort(result.latency.begin(), result.latency.end());
+        return true;
+    }
+
+    int PrintHelp(const char *basename)
+    {
+        COUT("Usage: " << basename << " [-n queries] [-s seed] [-g golden] [-u] maps...");
+        COUT("  -n\tqueries per map, default 2000");
+        COUT("  -s\trandom seed, default 1");
+        COUT("  -g\tgolden checksums file to compare with");
+        COUT("  -u\trewrite the golden file instead of comparing");
+        return EXIT_SUCCESS;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t queries = 2000;
+    uint32_t seed = 1;
+    string golden_file;
+    bool update = false;
+    vector<string> maps;
+
+    for (int ii = 1; ii < argc; ++ii)
+    {
+        const string arg(argv[ii]);
+
+        if (arg == "-n" && ii + 1 < argc)
+            queries = GetInt(argv[++ii]);
+        else if (arg == "-s" && ii + 1 < argc)
+            seed = GetInt(argv[++ii]);
+        else if (arg == "-g" && ii + 1 < argc)
+            golden_file = argv[++ii];
+        else if (arg == "-u")
+            update = true;
+        else if (arg == "-h")
+            return PrintHelp(argv[0]);
+        else
+            maps.push_back(arg);
+    }
+
+    if (maps.empty())
+        return PrintHelp(argv[0]);
+
+    Settings::Get().SetProgramPath(argv[0]);
+
+    map<string, string> golden = golden_file.empty() ? map<string, string>() : Bench::ReadGolden(golden_file);
+    bool mismatch = false;
+
+    for (const auto &file : maps)
+    {
+        const string name = System::GetBasename(file);
+        BenchResult result;
+
+        if (!RunMap(file, queries, seed, result))
+        {
+            ERROR("cannot run map: " << file);
+            mismatch = true;
+            continue;
+        }
+
+        double total = 0;
+        for (double value : result.latency)
+            total += value;
+
+        const string checksum = result.checksum.String();
+
+        COUT(name << ": load ms: " << result.load << ", addons KB: " << result.addons / 1024 <<
+             ", queries: " << queries << ", found: " << result.found <<
+             ", total ms: " << total / 1000 <<
+             ", p50 us: " << Bench::Percentile(result.latency, 0.5) <<
+             ", p90 us: " << Bench::Percentile(result.latency, 0.9) <<
+             ", p99 us: " << Bench::Percentile(result.latency, 0.99) <<
+             ", max us: " << Bench::Percentile(result.latency, 1.0) <<
+             ", expanded/query: " << result.expanded / max<uint32_t>(queries, 1) <<
+             ", checksum: " << checksum);
+
+        if (!golden_file.empty() && !update && golden.count(name) && golden[name] != checksum)
+        {
+            ERROR(name << ": routes differ from golden checksum " << golden[name]);
+            mismatch = true;
+        }
+
+        golden[name] = checksum;
+    }
+
+    if (update && !golden_file.empty())
+        Bench::WriteGolden(golden_file, golden);
+
+    return mismatch ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -45,6 +45,45 @@ uint32_t Rand::Get(uint32_t min, uint32_t max)
     return static_cast<uint32_t>((min + 1) * (rand() / (RAND_MAX + 1.0)));
 }
 
+uint32_t Rand::GetSeed()
+{
+    return (Get(0xFFFF) << 16) | Get(0xFFFF);
+}
+
+Rand::Stream::Stream(uint32_t value) : engine(value), seed(value)
+{
+}
+
+void Rand::Stream::Seed(uint32_t value)
+{
+    engine.seed(value);
+    seed = value;
+}
+
+uint32_t Rand::Stream::GetSeed() const
+{
+    return seed;
+}
+
+uint32_t Rand::Stream::Get(uint32_t min, uint32_t max)
+{
+    if (max)
+    {
+        if (min > max) swap(min, max);
+
+        return min + Get(max - min);
+    }
+
+    // the same mapping as Rand::Get, without the platform RAND_MAX
+    return static_cast<uint32_t>((static_cast<uint64_t>(min) + 1) * engine() >> 32);
+}
+
+Rand::Stream &Rand::Cosmetic()
+{
+    static Stream stream(static_cast<uint32_t>(time(nullptr)));
+    return stream;
+}
+
 Rand::Queue::Queue(uint32_t size)
 {
     reserve(size);
@@ -25,6 +25,7 @@
 #include <list>
 #include <utility>
 #include <iterator>
+#include <random>
 #include "types.h"
 
 using namespace std;
@@ -51,6 +52,37 @@ namespace Rand
         return it == lst.end() ? nullptr : &(*it);
     }
 
+    /* 32 bits from the global generator, to seed a Stream */
+    uint32_t GetSeed();
+
+    /* generator with its own state: one seed gives the same sequence on every platform and thread */
+    class Stream
+    {
+    public:
+        explicit Stream(uint32_t seed = 0);
+
+        void Seed(uint32_t);
+
+        uint32_t GetSeed() const;
+
+        uint32_t Get(uint32_t min, uint32_t max = 0);
+
+        template<typename T>
+        const T *Get(const vector<T> &vec)
+        {
+            typename vector<T>::const_iterator it = vec.begin();
+            std::advance(it, Get(vec.size() - 1));
+            return it == vec.end() ? nullptr : &(*it);
+        }
+
+    private:
+        mt19937 engine;
+        uint32_t seed;
+    };
+
+    /* animation and interface jitter only: nothing that changes the game draws from it */
+    Stream &Cosmetic();
+
     typedef pair<s32, uint32_t> ValuePercent;
 
     class Queue : private vector<ValuePercent>
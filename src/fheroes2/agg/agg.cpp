@@ -152,6 +152,9 @@ namespace AGG
     vector<loop_sound_t> loop_sounds;
     unordered_map<uint32_t, fnt_cache_t> fnt_cache;
 
+    // icn, index, reflect and effect as key
+    unordered_map<uint64_t, Surface> effect_cache;
+
     bool memlimit_usage = true;
 
 
@@ -351,6 +354,17 @@ uint32_t AGG::ClearFreeObjects()
     }
     total = 0;
 
+    // effect cache
+    for (auto it = effect_cache.begin(); it != effect_cache.end();)
+    {
+        if (!it->second.isRefCopy())
+        {
+            total += it->second.GetMemoryUsage();
+            it = effect_cache.erase(it);
+        } else
+            ++it;
+    }
+
     // icn cache
     uint32_t used = 0;
 
@@ -1054,6 +1068,34 @@ Sprite AGG::GetICN(int icn, uint32_t index, bool reflect)
     return result;
 }
 
+Surface AGG::GetICNEffect(int icn, uint32_t index, bool reflect, int effect)
+{
+    const uint64_t key = (static_cast<uint64_t>(icn) << 32) | (index << 2) | (reflect ? 2 : 0) | (effect & 1);
+    auto it = effect_cache.find(key);
+
+    if (it == effect_cache.end())
+    {
+        const Sprite sprite = GetICN(icn, index, reflect);
+        Surface &result = effect_cache[key];
+
+        switch (effect)
+        {
+            case EFFECT_CONTOUR:
+                result = sprite.RenderContour(RGBA(0xe0, 0xe0, 0));
+                break;
+            case EFFECT_GRAYSCALE:
+                result = sprite.RenderGrayScale();
+                break;
+            default:
+                break;
+        }
+
+        return result;
+    }
+
+    return it->second;
+}
+
 /* return count of sprites from specific ICN */
 uint32_t AGG::GetICNCount(int icn)
 {
@@ -1597,6 +1639,7 @@ void AGG::Quit()
     mid_cache.clear();
     loop_sounds.clear();
     fnt_cache.clear();
+    effect_cache.clear();
     pal_colors.clear();
     fonts = nullptr;
 }
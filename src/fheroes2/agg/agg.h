@@ -59,6 +59,14 @@ namespace AGG
 
     Sprite GetICN(int icn, uint32_t index, bool reflect = false);
 
+    enum
+    {
+        EFFECT_CONTOUR, EFFECT_GRAYSCALE
+    };
+
+    /* derived sprite, rendered on first use and shared by every caller */
+    Surface GetICNEffect(int icn, uint32_t index, bool reflect, int effect);
+
     uint32_t GetICNCount(int icn);
 
     Surface GetTIL(int til, uint32_t index, uint32_t shape);
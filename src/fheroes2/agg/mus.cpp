@@ -197,7 +197,7 @@ int MUS::FromMapObject(int object)
 
 int MUS::GetBattleRandom()
 {
-    switch (Rand::Get(1, 3))
+    switch (Rand::Cosmetic().Get(1, 3))
     {
         case 1:
             return BATTLE1;
@@ -25,6 +25,7 @@
 #include "settings.h"
 #include "kingdom.h"
 #include "battle.h"
+#include "battle_estimator.h"
 #include "luck.h"
 #include "morale.h"
 #include "game.h"
@@ -208,6 +209,9 @@ void AIBattleLose(Heroes &hero, const Battle::Result &res, bool attacker, int co
 
 void AI::HeroesAction(Heroes &hero, s32 dst_index)
 {
+    // pickups, fights and quantities
+    world.TileChanged(dst_index);
+
     const Maps::Tiles &tile = world.GetTiles(dst_index);
     const int object = (dst_index == hero.GetIndex() ?
                         tile.GetObject(false) : tile.GetObject());
@@ -1518,6 +1522,22 @@ void AIMeeting(Heroes &hero1, Heroes &hero2)
     // artifacts change
 }
 
+/* the strength comparison settles clear fights, simulated battles the close ones */
+bool AIHeroesWinBattle(const Heroes &hero, const Army &enemy, s32 index)
+{
+    const Army &army = hero.GetArmy();
+
+    if (!enemy.m_troops.isValid()) return true;
+
+    const uint32_t strength1 = army.m_troops.GetStrength();
+    const uint32_t strength2 = enemy.m_troops.GetStrength();
+
+    if (strength1 > 3 * strength2 || 3 * strength1 < strength2)
+        return Army::TroopsStrongerEnemyTroops(army.m_troops, enemy.m_troops);
+
+    return 0.7 <= Battle::Estimator().Get(army, enemy, index).win;
+}
+
 bool AI::HeroesValidObject(const Heroes &hero, s32 index)
 {
     Maps::Tiles &tile = world.GetTiles(index);
@@ -1566,7 +1586,7 @@ bool AI::HeroesValidObject(const Heroes &hero, s32 index)
                 if (tile.CaptureObjectIsProtection())
                 {
                     Army enemy(tile);
-                    return !enemy.m_troops.isValid() || Army::TroopsStrongerEnemyTroops(army.m_troops, enemy.m_troops);
+                    return !enemy.m_troops.isValid() || AIHeroesWinBattle(hero, enemy, index);
                 } else
                     return true;
             }
@@ -1590,7 +1610,7 @@ bool AI::HeroesValidObject(const Heroes &hero, s32 index)
                     {
                         Army enemy(tile);
                         return !enemy.m_troops.isValid() ||
-                               Army::TroopsStrongerEnemyTroops(army.m_troops, enemy.m_troops);
+                               AIHeroesWinBattle(hero, enemy, index);
                     } else
                         return true;
                 }
@@ -1627,7 +1647,7 @@ bool AI::HeroesValidObject(const Heroes &hero, s32 index)
             {
                 Army enemy(tile);
                 return !enemy.m_troops.isValid()
-                       || Army::TroopsStrongerEnemyTroops(army.m_troops, enemy.m_troops);
+                       || AIHeroesWinBattle(hero, enemy, index);
             }
             // other
             return true;
@@ -1839,7 +1859,7 @@ bool AI::HeroesValidObject(const Heroes &hero, s32 index)
             {
                 Army enemy(tile);
                 return enemy.m_troops.isValid()
-                       && Army::TroopsStrongerEnemyTroops(army.m_troops, enemy.m_troops);
+                       && AIHeroesWinBattle(hero, enemy, index);
             }
             break;
 
@@ -1853,7 +1873,7 @@ bool AI::HeroesValidObject(const Heroes &hero, s32 index)
         {
             Army enemy(tile);
             return !enemy.m_troops.isValid()
-                   || Army::TroopsStrongerEnemyTroops(army.m_troops, enemy.m_troops);
+                   || AIHeroesWinBattle(hero, enemy, index);
         }
             break;
 
@@ -1873,7 +1893,7 @@ bool AI::HeroesValidObject(const Heroes &hero, s32 index)
                 return nullptr == castle->GetHeroes().Guest() && !hero.isVisited(tile);
             // FIXME: AI skip visiting alliance
             if (hero.isFriends(castle->GetColor())) return false;
-            if (Army::TroopsStrongerEnemyTroops(army.m_troops, castle->GetActualArmy().m_troops)) return true;
+            if (AIHeroesWinBattle(hero, castle->GetActualArmy(), index)) return true;
             break;
         }
 
@@ -1888,7 +1908,7 @@ bool AI::HeroesValidObject(const Heroes &hero, s32 index)
             // FIXME: AI skip visiting alliance
             if (hero.isFriends(hero2->GetColor())) return false;
             if (hero2->AllowBattle(false) &&
-                Army::TroopsStrongerEnemyTroops(army.m_troops, hero2->GetArmy().m_troops))
+                AIHeroesWinBattle(hero, hero2->GetArmy(), index))
                 return true;
             break;
         }
@@ -1907,12 +1927,13 @@ bool AI::HeroesValidObject(const Heroes &hero, s32 index)
     return false;
 }
 
-bool AIHeroesShowAnimation(const Heroes &hero)
+/* colors whose view shows the AI moves: the human players and their friends */
+int AIHeroesViewColors()
 {
     const Settings &conf = Settings::Get();
 
     // accumulate colors
-    uint32_t colors = 0;
+    int colors = 0;
 
     if (conf.GameType() & Game::TYPE_HOTSEAT)
     {
@@ -1928,7 +1949,11 @@ bool AIHeroesShowAnimation(const Heroes &hero)
         if (player) colors = player->GetFriends();
     }
 
-    // get result
+    return colors;
+}
+
+bool AIHeroesShowAnimation(const Heroes &hero, int colors)
+{
     const s32 index_from = hero.GetIndex();
 
     if (!colors || !Maps::isValidAbsIndex(index_from))
@@ -1946,6 +1971,19 @@ bool AIHeroesShowAnimation(const Heroes &hero)
     return !tile_from.isFog(colors);
 }
 
+bool AIHeroesHideMove(const Heroes &hero, int colors)
+{
+    return 0 == Settings::Get().AIMoveSpeed() ||
+           (!IS_DEVEL() && !AIHeroesShowAnimation(hero, colors));
+}
+
+/* steps in the fog go at once, without events, redraws, sounds and delays */
+void AIHeroesMoveHidden(Heroes &hero, int colors)
+{
+    while (!hero.isFreeman() && hero.isEnableMove() && AIHeroesHideMove(hero, colors))
+        hero.Move(true);
+}
+
 void AI::HeroesMove(Heroes &hero)
 {
     if (!hero.GetPath().isValid())
@@ -1953,13 +1991,30 @@ void AI::HeroesMove(Heroes &hero)
     hero.SetMove(true);
 
     const Settings &conf = Settings::Get();
+
+    // autoplay: no events, redraws and delays
+    if (conf.Headless())
+    {
+        while (!hero.isFreeman() && hero.isEnableMove())
+            hero.Move(true);
+        return;
+    }
+
+    const int colors = AIHeroesViewColors();
+
+    // the whole way may be out of sight
+    AIHeroesMoveHidden(hero, colors);
+
+    if (hero.isFreeman() || !hero.isEnableMove())
+        return;
+
     Display &display = Display::Get();
     Cursor &cursor = Cursor::Get();
     Interface::Basic &I = Interface::Basic::Get();
 
     cursor.Hide();
 
-    if (0 != conf.AIMoveSpeed() && AIHeroesShowAnimation(hero))
+    if (!AIHeroesHideMove(hero, colors))
     {
         cursor.Hide();
         I.GetGameArea().SetCenter(hero.GetCenter());
@@ -1972,13 +2027,14 @@ void AI::HeroesMove(Heroes &hero)
     {
         if (hero.isFreeman() || !hero.isEnableMove()) break;
 
-        bool hide_move = (0 == conf.AIMoveSpeed()) ||
-                         (!IS_DEVEL() && !AIHeroesShowAnimation(hero));
-
-        if (hide_move)
+        if (AIHeroesHideMove(hero, colors))
         {
-            hero.Move(true);
-        } else if (AnimateInfrequentDelay(Game::CURRENT_AI_DELAY))
+            // left the view
+            AIHeroesMoveHidden(hero, colors);
+            continue;
+        }
+
+        if (AnimateInfrequentDelay(Game::CURRENT_AI_DELAY))
         {
             cursor.Hide();
             hero.Move();
@@ -2000,9 +2056,6 @@ void AI::HeroesMove(Heroes &hero)
         }
     }
 
-    bool hide_move = (0 == conf.AIMoveSpeed()) ||
-                     (!IS_DEVEL() && !AIHeroesShowAnimation(hero));
-
     // 0.2 sec delay for show enemy hero position
-    if (!hero.isFreeman() && !hide_move) DELAY(200);
+    if (!hero.isFreeman() && !AIHeroesHideMove(hero, colors)) DELAY(200);
 }
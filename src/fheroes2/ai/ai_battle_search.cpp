@@ -0,0 +1,918 @@
+/***************************************************************************
+ *   Copyright (C) 2012 by Andrey Afletdinov <fheroes2@gmail.com>          *
+ *                                                                         *
+ *   Part of the Free Heroes2 Engine:                                      *
+ *   http://sourceforge.net/projects/fheroes2                              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <thread>
+
+#include "battle_arena.h"
+#include "battle_army.h"
+#include "battle_command.h"
+#include "battle_state.h"
+#include "battle_troop.h"
+#include "speed.h"
+#include "ai_battle_search.h"
+
+using namespace Battle;
+
+namespace
+{
+    enum
+    {
+        MAXUNITS = STATEUNITS, MAXMOVES = 3 * MAXUNITS + 1, MAXDEPTH = 48, FIXEDDEPTH = 4, TABLESIZE = 1 << 15
+    };
+
+    enum
+    {
+        MOVE_SKIP, MOVE_WALK, MOVE_ATTACK, MOVE_SHOOT
+    };
+
+    enum
+    {
+        BOUND_EXACT, BOUND_LOWER, BOUND_UPPER
+    };
+
+    const double infinity = numeric_limits<double>::infinity();
+
+    // a destroyed army outweighs any material difference
+    const double victory = 1e9;
+
+    uint64_t SplitMix(uint64_t value)
+    {
+        value += 0x9E3779B97F4A7C15ull;
+        value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+        value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+        return value ^ (value >> 31);
+    }
+
+    /* Zobrist keys of the unit positions and flags; hit points and shots are mixed in */
+    struct ZobristKeys
+    {
+        ZobristKeys()
+        {
+            uint64_t seed = 0;
+
+            for (auto &unit : head)
+                for (auto &key : unit)
+                    key = SplitMix(++seed);
+
+            for (int ii = 0; ii < MAXUNITS; ++ii)
+            {
+                moved[ii] = SplitMix(++seed);
+                responded[ii] = SplitMix(++seed);
+            }
+
+            for (auto &key : next)
+                key = SplitMix(++seed);
+        }
+
+        static uint64_t Value(int unit, uint32_t kind, uint32_t value)
+        {
+            return SplitMix((static_cast<uint64_t>(unit * 2 + kind) << 32) ^ value);
+        }
+
+        uint64_t head[MAXUNITS][ARENASIZE];
+        uint64_t moved[MAXUNITS];
+        uint64_t responded[MAXUNITS];
+        uint64_t next[MAXUNITS + 1];
+    };
+
+    const ZobristKeys &Zobrist()
+    {
+        static const ZobristKeys keys;
+        return keys;
+    }
+
+    struct SearchMove
+    {
+        SearchMove() : type(MOVE_SKIP), cell(-1), target(-1)
+        {}
+
+        SearchMove(u8 tp, s8 cl, s8 tg) : type(tp), cell(cl), target(tg)
+        {}
+
+        bool operator==(const SearchMove &move) const
+        { return type == move.type && cell == move.cell && target == move.target; }
+
+        u8 type;
+        s8 cell;
+        s8 target;
+    };
+
+    /* what the search does not change */
+    struct SearchUnitInfo
+    {
+        const Unit *unit;
+        int side;           // 0: the side to move at the root
+        uint32_t unit_hp;   // hit points of one creature
+        uint32_t speed;
+        bool passive;       // blind, paralyzed or standing
+        bool wide;
+        bool reflect;
+        bool fly;
+        bool hideattack;
+        bool alwaysresponse;
+        bool twice;
+        double value;       // strength of one hit point
+    };
+
+    /* what it does, copied at every node */
+    struct SearchUnit
+    {
+        uint32_t hp;        // 0: dead
+        s8 head;
+        u8 shots;
+        bool moved;
+        bool responded;
+    };
+
+    struct SearchState
+    {
+        SearchUnit units[MAXUNITS];
+        u8 next;            // position in the turn order
+        uint64_t hash;
+    };
+
+    struct TableEntry
+    {
+        TableEntry() : key(0), value(0), depth(-1), bound(BOUND_EXACT)
+        {}
+
+        uint64_t key;
+        double value;
+        s8 depth;
+        u8 bound;
+        SearchMove best;
+    };
+
+    /* wall clock and node limits shared by the workers */
+    struct SearchClock
+    {
+        SearchClock(const AI::BattleSearchLimits &limits) :
+                stop(chrono::steady_clock::now() + chrono::milliseconds(limits.budget)),
+                timed(0 < limits.budget), maxnodes(limits.nodes), nodes(0), abort(false)
+        {}
+
+        bool Expired()
+        {
+            if (!abort && ((maxnodes && nodes >= maxnodes) || (timed && chrono::steady_clock::now() >= stop)))
+                abort = true;
+            return abort;
+        }
+
+        chrono::steady_clock::time_point stop;
+        bool timed;
+        uint64_t maxnodes;
+        atomic<uint64_t> nodes;
+        atomic<bool> abort;
+    };
+
+    class SearchModel
+    {
+    public:
+        bool Init(Arena &, const Unit &, SearchState &);
+
+        int NextUnit(SearchState &) const;
+
+        int Moves(const SearchState &, int unit, SearchMove *) const;
+
+        void Apply(SearchState &, int unit, const SearchMove &) const;
+
+        double Evaluate(const SearchState &) const;
+
+        double MoveScore(const SearchState &, int unit, const SearchMove &) const;
+
+        const Unit *GetUnit(int unit) const
+        { return infos[unit].unit; }
+
+        int GetSide(int unit) const
+        { return infos[unit].side; }
+
+    private:
+        s32 Tail(int unit, s32 head) const;
+
+        void Occupy(const SearchState &, s8 *) const;
+
+        void Reach(const SearchState &, int unit, const s8 *, s8 *) const;
+
+        bool Free(int unit, s32 cell, const s8 *) const;
+
+        uint32_t Count(const SearchState &, int unit) const;
+
+        void SetHp(SearchState &, int unit, uint32_t) const;
+
+        void SetHead(SearchState &, int unit, s32) const;
+
+        void SetShots(SearchState &, int unit, uint32_t) const;
+
+        void SetMoved(SearchState &, int unit, bool) const;
+
+        void SetResponded(SearchState &, int unit, bool) const;
+
+        void SetNext(SearchState &, u8) const;
+
+        void Damage(SearchState &, int attacker, int defender, bool ranged) const;
+
+        int count;
+        SearchUnitInfo infos[MAXUNITS];
+        double melee[MAXUNITS][MAXUNITS];   // damage of one creature
+        double ranged[MAXUNITS][MAXUNITS];
+        u8 order[MAXUNITS];
+        bool obstacle[ARENASIZE];
+    };
+
+    bool SearchModel::Init(Arena &arena, const Unit &current, SearchState &root)
+    {
+        const ZobristKeys &keys = Zobrist();
+        State snapshot;
+
+        if (!snapshot.Capture(arena)) return false;
+
+        count = 0;
+        root.hash = 0;
+
+        for (uint32_t slot = 0; slot < snapshot.size; ++slot)
+        {
+            const Unit *unit = arena.GetTroopUID(snapshot.uid[slot]);
+            if (!unit || !snapshot.count[slot]) continue;
+
+            SearchUnitInfo &info = infos[count];
+            SearchUnit &state = root.units[count];
+            const uint32_t modes = snapshot.modes[slot];
+
+            info.unit = unit;
+            info.side = unit->GetColor() == current.GetColor() ? 0 : 1;
+            info.unit_hp = max(1u, unit->Monster::GetHitPoints());
+            info.speed = unit->GetSpeed(true);
+            info.passive = Speed::STANDING == info.speed || (modes & (SP_BLIND | IS_PARALYZE_MAGIC));
+            info.wide = unit->isWide();
+            info.reflect = snapshot.reflect[slot];
+            info.fly = unit->isFly();
+            info.hideattack = unit->isHideAttack();
+            info.alwaysresponse = unit->isAlwayResponse();
+            info.twice = unit->isTwiceAttack();
+            info.value = max(1u, Troop(*unit, 1).GetStrength()) / static_cast<double>(info.unit_hp);
+
+            state.hp = snapshot.hp[slot];
+            state.head = snapshot.head[slot];
+            state.shots = min(255u, snapshot.shots[slot]);
+            state.moved = modes & TR_MOVED;
+            state.responded = modes & TR_RESPONSED;
+
+            root.hash ^= keys.head[count][state.head] ^ ZobristKeys::Value(count, 0, state.hp) ^
+                         ZobristKeys::Value(count, 1, state.shots);
+            if (state.moved) root.hash ^= keys.moved[count];
+            if (state.responded) root.hash ^= keys.responded[count];
+
+            ++count;
+        }
+
+        // average damage of one creature: archers at half strength in melee
+        for (int ii = 0; ii < count; ++ii)
+        {
+            const Unit &attacker = *infos[ii].unit;
+            const double creatures = max(1u, attacker.GetCount());
+            const bool fullmelee = Monster::MAGE == attacker.GetID() || Monster::ARCHMAGE == attacker.GetID() ||
+                                   Monster::TITAN == attacker.GetID();
+
+            for (int jj = 0; jj < count; ++jj)
+            {
+                const Unit &defender = *infos[jj].unit;
+                const double damage = (attacker.GetDamageMin(defender) + attacker.GetDamageMax(defender)) / 2.0 /
+                                      creatures;
+
+                if (!attacker.isArchers() || fullmelee)
+                {
+                    melee[ii][jj] = damage;
+                    ranged[ii][jj] = damage;
+                } else if (attacker.isHandFighting())
+                {
+                    melee[ii][jj] = damage;
+                    ranged[ii][jj] = 2 * damage;
+                } else
+                {
+                    melee[ii][jj] = damage / 2;
+                    ranged[ii][jj] = damage;
+                }
+            }
+        }
+
+        // fastest first, the attacker on ties
+        for (int ii = 0; ii < count; ++ii)
+            order[ii] = ii;
+
+        stable_sort(order, order + count, [this](u8 unit1, u8 unit2)
+        {
+            return infos[unit1].speed > infos[unit2].speed;
+        });
+
+        for (s32 index = 0; index < ARENASIZE; ++index)
+        {
+            const Cell *cell = Board::GetCell(index);
+            obstacle[index] = !cell || !cell->isPassable1(false);
+        }
+
+        // the root unit moves first
+        root.next = 0;
+
+        for (int ii = 0; ii < count; ++ii)
+            if (infos[order[ii]].unit == &current)
+                root.next = ii;
+
+        root.hash ^= keys.next[root.next];
+
+        return infos[order[root.next]].unit == &current;
+    }
+
+    s32 SearchModel::Tail(int unit, s32 head) const
+    {
+        if (!infos[unit].wide) return -1;
+
+        const s32 tail = head + (infos[unit].reflect ? 1 : -1);
+        return 0 <= tail && tail < ARENASIZE && tail / ARENAW == head / ARENAW ? tail : -1;
+    }
+
+    void SearchModel::Occupy(const SearchState &state, s8 *cells) const
+    {
+        fill(cells, cells + ARENASIZE, -1);
+
+        for (int ii = 0; ii < count; ++ii)
+        {
+            const SearchUnit &unit = state.units[ii];
+            if (!unit.hp) continue;
+
+            cells[unit.head] = ii;
+
+            const s32 tail = Tail(ii, unit.head);
+            if (0 <= tail) cells[tail] = ii;
+        }
+    }
+
+    bool SearchModel::Free(int unit, s32 cell, const s8 *cells) const
+    {
+        if (obstacle[cell] || (0 <= cells[cell] && unit != cells[cell])) return false;
+
+        const s32 tail = Tail(unit, cell);
+        return !infos[unit].wide ||
+               (0 <= tail && !obstacle[tail] && (0 > cells[tail] || unit == cells[tail]));
+    }
+
+    /* steps to every free cell the unit reaches this turn, -1 for the others */
+    void SearchModel::Reach(const SearchState &state, int unit, const s8 *cells, s8 *steps) const
+    {
+        const SearchUnitInfo &info = infos[unit];
+        const s32 head = state.units[unit].head;
+
+        fill(steps, steps + ARENASIZE, -1);
+
+        if (info.fly)
+        {
+            for (s32 index = 0; index < ARENASIZE; ++index)
+                if (Free(unit, index, cells))
+                    steps[index] = HexMath::Steps(head, index);
+            return;
+        }
+
+        s8 queue[ARENASIZE];
+        int first = 0;
+        int last = 0;
+
+        steps[head] = 0;
+        queue[last++] = head;
+
+        while (first < last)
+        {
+            const s32 index = queue[first++];
+
+            if (static_cast<uint32_t>(steps[index]) >= info.speed) continue;
+
+            for (const s32 around : Board::GetAroundSpan(index))
+                if (0 > steps[around] && !obstacle[around] && (0 > cells[around] || unit == cells[around]))
+                {
+                    steps[around] = steps[index] + 1;
+                    queue[last++] = around;
+                }
+        }
+
+        // wide units need the tail cell too
+        if (info.wide)
+            for (s32 index = 0; index < ARENASIZE; ++index)
+                if (0 < steps[index] && !Free(unit, index, cells))
+                    steps[index] = -1;
+    }
+
+    uint32_t SearchModel::Count(const SearchState &state, int unit) const
+    {
+        return (state.units[unit].hp + infos[unit].unit_hp - 1) / infos[unit].unit_hp;
+    }
+
+    void SearchModel::SetHp(SearchState &state, int unit, uint32_t hp) const
+    {
+        state.hash ^= ZobristKeys::Value(unit, 0, state.units[unit].hp) ^ ZobristKeys::Value(unit, 0, hp);
+        state.units[unit].hp = hp;
+    }
+
+    void SearchModel::SetHead(SearchState &state, int unit, s32 head) const
+    {
+        const ZobristKeys &keys = Zobrist();
+        state.hash ^= keys.head[unit][state.units[unit].head] ^ keys.head[unit][head];
+        state.units[unit].head = head;
+    }
+
+    void SearchModel::SetShots(SearchState &state, int unit, uint32_t shots) const
+    {
+        state.hash ^= ZobristKeys::Value(unit, 1, state.units[unit].shots) ^ ZobristKeys::Value(unit, 1, shots);
+        state.units[unit].shots = shots;
+    }
+
+    void SearchModel::SetMoved(SearchState &state, int unit, bool moved) const
+    {
+        if (state.units[unit].moved != moved) state.hash ^= Zobrist().moved[unit];
+        state.units[unit].moved = moved;
+    }
+
+    void SearchModel::SetResponded(SearchState &state, int unit, bool responded) const
+    {
+        if (state.units[unit].responded != responded) state.hash ^= Zobrist().responded[unit];
+        state.units[unit].responded = responded;
+    }
+
+    void SearchModel::SetNext(SearchState &state, u8 next) const
+    {
+        const ZobristKeys &keys = Zobrist();
+        state.hash ^= keys.next[state.next] ^ keys.next[next];
+        state.next = next;
+    }
+
+    /* the unit to act, a new round when every unit has acted; -1 when the battle is over */
+    int SearchModel::NextUnit(SearchState &state) const
+    {
+        bool alive[2] = {false, false};
+
+        for (int ii = 0; ii < count; ++ii)
+            if (state.units[ii].hp) alive[infos[ii].side] = true;
+
+        if (!alive[0] || !alive[1]) return -1;
+
+        for (int round = 0; round < 2; ++round)
+        {
+            for (int pos = state.next; pos < count; ++pos)
+            {
+                const int unit = order[pos];
+                const SearchUnit &current = state.units[unit];
+
+                if (current.hp && !current.moved && !infos[unit].passive)
+                {
+                    SetNext(state, pos);
+                    return unit;
+                }
+            }
+
+            // new round
+            for (int ii = 0; ii < count; ++ii)
+            {
+                SetMoved(state, ii, false);
+                SetResponded(state, ii, false);
+            }
+
+            SetNext(state, 0);
+        }
+
+        return -1;
+    }
+
+    void SearchModel::Damage(SearchState &state, int attacker, int defender, bool shot) const
+    {
+        const double damage = (shot ? ranged : melee)[attacker][defender] * Count(state, attacker);
+        const uint32_t hp = state.units[defender].hp;
+
+        SetHp(state, defender, damage >= hp ? 0 : hp - static_cast<uint32_t>(damage));
+    }
+
+    int SearchModel::Moves(const SearchState &state, int unit, SearchMove *moves) const
+    {
+        const SearchUnit &current = state.units[unit];
+        s8 cells[ARENASIZE];
+        s8 steps[ARENASIZE];
+        int size = 0;
+
+        Occupy(state, cells);
+        Reach(state, unit, cells, steps);
+
+        // an enemy around blocks the shots
+        bool blocked = false;
+        const s32 tail = Tail(unit, current.head);
+
+        for (const s32 around : Board::GetAroundSpan(current.head))
+            if (0 <= cells[around] && infos[cells[around]].side != infos[unit].side) blocked = true;
+
+        if (0 <= tail)
+            for (const s32 around : Board::GetAroundSpan(tail))
+                if (0 <= cells[around] && infos[cells[around]].side != infos[unit].side) blocked = true;
+
+        for (int enemy = 0; enemy < count; ++enemy)
+        {
+            const SearchUnit &target = state.units[enemy];
+            if (!target.hp || infos[enemy].side == infos[unit].side) continue;
+
+            if (current.shots && !blocked)
+                moves[size++] = SearchMove(MOVE_SHOOT, -1, enemy);
+
+            // the nearest cell around the enemy
+            s32 attack = -1;
+            const s32 heads[] = {target.head, Tail(enemy, target.head)};
+
+            for (const s32 head : heads)
+            {
+                if (0 > head) continue;
+
+                for (const s32 around : Board::GetAroundSpan(head))
+                    if (0 <= steps[around] && (0 > attack || steps[around] < steps[attack] ||
+                                              (steps[around] == steps[attack] && around < attack)))
+                        attack = around;
+            }
+
+            if (0 <= attack)
+            {
+                moves[size++] = SearchMove(MOVE_ATTACK, attack, enemy);
+                continue;
+            }
+
+            // out of reach: the free cell nearest to the enemy
+            s32 walk = -1;
+
+            for (s32 index = 0; index < ARENASIZE; ++index)
+                if (0 < steps[index] && (0 > walk || HexMath::Steps(index, target.head) < HexMath::Steps(walk, target.head)))
+                    walk = index;
+
+            const SearchMove move(MOVE_WALK, walk, -1);
+
+            if (0 <= walk && find(moves, moves + size, move) == moves + size)
+                moves[size++] = move;
+        }
+
+        moves[size++] = SearchMove();
+
+        return size;
+    }
+
+    void SearchModel::Apply(SearchState &state, int unit, const SearchMove &move) const
+    {
+        switch (move.type)
+        {
+            case MOVE_WALK:
+                SetHead(state, unit, move.cell);
+                break;
+
+            case MOVE_SHOOT:
+                Damage(state, unit, move.target, true);
+                SetShots(state, unit, state.units[unit].shots - 1);
+
+                if (infos[unit].twice && state.units[unit].shots && state.units[move.target].hp)
+                {
+                    Damage(state, unit, move.target, true);
+                    SetShots(state, unit, state.units[unit].shots - 1);
+                }
+                break;
+
+            case MOVE_ATTACK:
+            {
+                const int enemy = move.target;
+
+                SetHead(state, unit, move.cell);
+                Damage(state, unit, enemy, false);
+
+                if (state.units[enemy].hp && !infos[unit].hideattack &&
+                    (!state.units[enemy].responded || infos[enemy].alwaysresponse))
+                {
+                    Damage(state, enemy, unit, false);
+                    SetResponded(state, enemy, true);
+                }
+
+                if (infos[unit].twice && state.units[unit].hp && state.units[enemy].hp)
+                    Damage(state, unit, enemy, false);
+                break;
+            }
+
+            default:
+                break;
+        }
+
+        SetMoved(state, unit, true);
+    }
+
+    double SearchModel::Evaluate(const SearchState &state) const
+    {
+        double sides[2] = {0, 0};
+
+        for (int ii = 0; ii < count; ++ii)
+            sides[infos[ii].side] += state.units[ii].hp * infos[ii].value;
+
+        if (0 == sides[1]) return victory + sides[0];
+        if (0 == sides[0]) return -victory - sides[1];
+
+        return sides[0] - sides[1];
+    }
+
+    /* move ordering: the most strength taken first, skipping last */
+    double SearchModel::MoveScore(const SearchState &state, int unit, const SearchMove &move) const
+    {
+        if (MOVE_SKIP == move.type) return -1;
+        if (MOVE_WALK == move.type) return 0;
+
+        const double damage = (MOVE_SHOOT == move.type ? ranged : melee)[unit][move.target] * Count(state, unit);
+        return min(damage, static_cast<double>(state.units[move.target].hp)) * infos[move.target].value;
+    }
+
+    class Searcher
+    {
+    public:
+        Searcher(const SearchModel &sm, SearchClock &sc) : model(sm), clock(sc), table(TABLESIZE), nodes(0)
+        {}
+
+        double AlphaBeta(const SearchState &, int depth, double alpha, double beta);
+
+        uint64_t GetNodes() const
+        { return nodes; }
+
+    private:
+        int OrderMoves(const SearchState &, int unit, SearchMove *, const SearchMove &hint) const;
+
+        const SearchModel &model;
+        SearchClock &clock;
+        vector<TableEntry> table;
+        uint64_t nodes;
+    };
+
+    int Searcher::OrderMoves(const SearchState &state, int unit, SearchMove *moves, const SearchMove &hint) const
+    {
+        const int size = model.Moves(state, unit, moves);
+        double scores[MAXMOVES];
+
+        for (int ii = 0; ii < size; ++ii)
+            scores[ii] = moves[ii] == hint ? infinity : model.MoveScore(state, unit, moves[ii]);
+
+        // insertion sort, a few moves only
+        for (int ii = 1; ii < size; ++ii)
+            for (int jj = ii; jj > 0 && scores[jj - 1] < scores[jj]; --jj)
+            {
+                swap(scores[jj - 1], scores[jj]);
+                swap(moves[jj - 1], moves[jj]);
+            }
+
+        return size;
+    }
+
+    double Searcher::AlphaBeta(const SearchState &node, int depth, double alpha, double beta)
+    {
+        if (0 == (++nodes & 255))
+        {
+            clock.nodes += 256;
+            clock.Expired();
+        }
+
+        if (clock.abort) return 0;
+
+        SearchState state = node;
+        const int unit = model.NextUnit(state);
+
+        if (0 > unit || 0 == depth)
+            return model.Evaluate(state);
+
+        TableEntry &entry = table[state.hash & (TABLESIZE - 1)];
+        SearchMove hint;
+
+        if (entry.key == state.hash)
+        {
+            if (entry.depth >= depth &&
+                (BOUND_EXACT == entry.bound ||
+                 (BOUND_LOWER == entry.bound && entry.value >= beta) ||
+                 (BOUND_UPPER == entry.bound && entry.value <= alpha)))
+                return entry.value;
+
+            hint = entry.best;
+        }
+
+        SearchMove moves[MAXMOVES];
+        const int size = OrderMoves(state, unit, moves, hint);
+        const double alpha0 = alpha;
+        const double beta0 = beta;
+        const bool max_node = 0 == model.GetSide(unit);
+        double best = max_node ? -infinity : infinity;
+        SearchMove best_move = moves[0];
+
+        for (int ii = 0; ii < size; ++ii)
+        {
+            SearchState child = state;
+            model.Apply(child, unit, moves[ii]);
+
+            const double value = AlphaBeta(child, depth - 1, alpha, beta);
+            if (clock.abort) return 0;
+
+            if (max_node ? value > best : value < best)
+            {
+                best = value;
+                best_move = moves[ii];
+            }
+
+            if (max_node)
+                alpha = max(alpha, best);
+            else
+                beta = min(beta, best);
+
+            if (alpha >= beta) break;
+        }
+
+        entry.key = state.hash;
+        entry.value = best;
+        entry.depth = depth;
+        entry.best = best_move;
+        entry.bound = best <= alpha0 ? BOUND_UPPER : best >= beta0 ? BOUND_LOWER : BOUND_EXACT;
+
+        return best;
+    }
+
+    struct RootMove
+    {
+        SearchMove move;
+        double value;
+    };
+
+    /* one depth of the root moves, split between the threads */
+    bool SearchRoot(const SearchModel &model, const SearchState &root, int unit, int depth,
+                    vector<RootMove> &moves, vector<up<Searcher>> &searchers, SearchClock &clock)
+    {
+        const bool max_node = 0 == model.GetSide(unit);
+        atomic<size_t> next(0);
+
+        auto work = [&](Searcher &searcher)
+        {
+            double alpha = -infinity;
+            double beta = infinity;
+
+            for (size_t ii = next++; ii < moves.size() && !clock.abort; ii = next++)
+            {
+                SearchState child = root;
+                model.Apply(child, unit, moves[ii].move);
+                moves[ii].value = searcher.AlphaBeta(child, depth - 1, alpha, beta);
+
+                if (max_node)
+                    alpha = max(alpha, moves[ii].value);
+                else
+                    beta = min(beta, moves[ii].value);
+            }
+        };
+
+        vector<thread> threads;
+
+        for (size_t ii = 1; ii < searchers.size(); ++ii)
+            threads.emplace_back(work, ref(*searchers[ii]));
+
+        work(*searchers.front());
+
+        for (auto &th : threads)
+            th.join();
+
+        if (clock.abort) return false;
+
+        // the best first, for the next depth and for the answer
+        stable_sort(moves.begin(), moves.end(), [max_node](const RootMove &move1, const RootMove &move2)
+        {
+            return max_node ? move1.value > move2.value : move1.value < move2.value;
+        });
+
+        return true;
+    }
+
+    /* the move as arena commands, false if the arena disagrees with the model */
+    bool PushCommands(Arena &arena, const Unit &unit, const SearchModel &model, const SearchMove &move,
+                      Actions &actions)
+    {
+        if (MOVE_WALK == move.type || MOVE_ATTACK == move.type)
+        {
+            if (move.cell != unit.GetHeadIndex())
+            {
+                Indexes path;
+
+                if (unit.isFly())
+                {
+                    const Cell *cell = Board::GetCell(move.cell);
+                    if (!cell || !cell->isPassable3(unit, false)) return false;
+                } else
+                {
+                    const Position pos = Position::GetCorrect(unit, move.cell);
+                    path = arena.GetPath(unit, pos);
+
+                    if (path.empty() || !pos.GetHead() ||
+                        (path.back() != pos.GetHead()->GetIndex() &&
+                         (!pos.GetTail() || path.back() != pos.GetTail()->GetIndex())))
+                        return false;
+                }
+
+                actions.push_back(Command(MSG_BATTLE_MOVE, unit.GetUID(), unit.isFly() ? move.cell : path.back()));
+            }
+        }
+
+        if (MOVE_ATTACK == move.type || MOVE_SHOOT == move.type)
+        {
+            const Unit *enemy = model.GetUnit(move.target);
+            actions.push_back(Command(MSG_BATTLE_ATTACK, unit.GetUID(), enemy->GetUID(), enemy->GetHeadIndex(), 0));
+        }
+
+        if (MOVE_SKIP == move.type)
+            actions.push_back(Command(MSG_BATTLE_SKIP, unit.GetUID(), 1));
+
+        actions.push_back(Command(MSG_BATTLE_END_TURN, unit.GetUID()));
+        return true;
+    }
+}
+
+bool AI::BattleSearchTurn(Arena &arena, const Unit &unit, Actions &actions, const BattleSearchLimits &limits,
+                          BattleSearchStats *stats)
+{
+    up<SearchModel> model(new SearchModel());
+    SearchState root;
+
+    if (!model->Init(arena, unit, root))
+        return false;
+
+    SearchState state = root;
+    const int current = model->NextUnit(state);
+    if (0 > current || model->GetUnit(current) != &unit)
+        return false;
+
+    SearchMove buffer[MAXMOVES];
+    const int size = model->Moves(root, current, buffer);
+    vector<RootMove> moves(size);
+
+    for (int ii = 0; ii < size; ++ii)
+    {
+        moves[ii].move = buffer[ii];
+        moves[ii].value = model->MoveScore(root, current, buffer[ii]);
+    }
+
+    stable_sort(moves.begin(), moves.end(), [](const RootMove &move1, const RootMove &move2)
+    {
+        return move1.value > move2.value;
+    });
+
+    const uint32_t threads = limits.threads ? limits.threads : max(1u, thread::hardware_concurrency());
+    SearchClock clock(limits);
+    vector<up<Searcher>> searchers;
+
+    for (uint32_t ii = 0; ii < threads; ++ii)
+        searchers.emplace_back(new Searcher(*model, clock));
+
+    SearchMove best = moves.front().move;
+    const uint32_t horizon = limits.budget || limits.nodes ? MAXDEPTH : FIXEDDEPTH;
+    uint32_t depth = 0;
+
+    // without limits the search stops at a fixed depth
+    while (depth < horizon && !clock.Expired())
+    {
+        vector<RootMove> iteration = moves;
+
+        if (!SearchRoot(*model, root, current, depth + 1, iteration, searchers, clock))
+            break;
+
+        moves.swap(iteration);
+        best = moves.front().move;
+        ++depth;
+
+        // the outcome is known
+        if (fabs(moves.front().value) >= victory) break;
+    }
+
+    if (stats)
+    {
+        stats->depth = depth;
+        stats->nodes = 0;
+
+        for (const auto &searcher : searchers)
+            stats->nodes += searcher->GetNodes();
+    }
+
+    return PushCommands(arena, unit, *model, best, actions);
+}
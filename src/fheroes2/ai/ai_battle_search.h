@@ -0,0 +1,62 @@
+/***************************************************************************
+ *   Copyright (C) 2012 by Andrey Afletdinov <fheroes2@gmail.com>          *
+ *                                                                         *
+ *   Part of the Free Heroes2 Engine:                                      *
+ *   http://sourceforge.net/projects/fheroes2                              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#pragma once
+
+#include "types.h"
+
+namespace Battle
+{
+    class Arena;
+
+    class Unit;
+
+    class Actions;
+}
+
+namespace AI
+{
+    struct BattleSearchLimits
+    {
+        BattleSearchLimits(uint32_t ms = 0, uint32_t count = 0, uint32_t workers = 1) :
+                budget(ms), nodes(count), threads(workers)
+        {}
+
+        uint32_t budget;  // wall clock ms per turn, 0: no limit; without both limits a fixed depth
+        uint32_t nodes;   // nodes per turn, 0: no limit; with one thread and no budget the search is repeatable
+        uint32_t threads; // 0 for one per core
+    };
+
+    struct BattleSearchStats
+    {
+        BattleSearchStats() : nodes(0), depth(0)
+        {}
+
+        uint64_t nodes;
+        uint32_t depth;   // last completed iteration
+    };
+
+    /* iterative deepening alpha-beta over a light copy of the battle: moves, melee, shots and
+       retaliation with average damage; false leaves the turn to the simple AI */
+    bool BattleSearchTurn(Battle::Arena &, const Battle::Unit &, Battle::Actions &,
+                          const BattleSearchLimits &, BattleSearchStats * = nullptr);
+}
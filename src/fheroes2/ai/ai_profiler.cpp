@@ -0,0 +1,115 @@
+/***************************************************************************
+ *   Copyright (C) 2012 by Andrey Afletdinov <fheroes2@gmail.com>          *
+ *                                                                         *
+ *   Part of the Free Heroes2 Engine:                                      *
+ *   http://sourceforge.net/projects/fheroes2                              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include <atomic>
+#include <fstream>
+#include <iostream>
+
+#include "settings.h"
+#include "world.h"
+#include "color.h"
+#include "system.h"
+#include "ai_profiler.h"
+
+namespace
+{
+    const char *phaseNames[] = {"scan", "castle", "task", "added_task", "path", "battle"};
+
+    const char *counterNames[] = {"paths_found", "paths_failed", "battles", "objects"};
+
+    // nanoseconds, the path phase comes from the planning threads
+    atomic<uint64_t> phases[AI::Profiler::PHASES];
+    atomic<uint32_t> counters[AI::Profiler::COUNTERS];
+
+    std::chrono::steady_clock::time_point turn_start;
+
+    double Milliseconds(uint64_t ns)
+    {
+        return ns / 1000000.0;
+    }
+}
+
+bool AI::Profiler::isEnabled()
+{
+    return !Settings::Get().AIProfile().empty();
+}
+
+void AI::Profiler::BeginTurn()
+{
+    for (auto &phase : phases) phase = 0;
+    for (auto &counter : counters) counter = 0;
+
+    turn_start = std::chrono::steady_clock::now();
+}
+
+void AI::Profiler::EndTurn(int color)
+{
+    if (!isEnabled()) return;
+
+    const double turn = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - turn_start).count();
+    const string &file = Settings::Get().AIProfile();
+    const bool header = !System::IsFile(file);
+    ofstream fs(file.c_str(), ios::app);
+
+    if (!fs)
+    {
+        ERROR("cannot write AI profile: " << file);
+        return;
+    }
+
+    if (header)
+    {
+        fs << "day,color,turn_ms";
+        for (const char *name : phaseNames) fs << "," << name << "_ms";
+        for (const char *name : counterNames) fs << "," << name;
+        fs << endl;
+    }
+
+    fs << world.CountDay() << "," << Color::String(color) << "," << turn;
+    for (const auto &phase : phases) fs << "," << Milliseconds(phase);
+    for (const auto &counter : counters) fs << "," << counter;
+    fs << endl;
+
+    VERBOSE(Color::String(color) << " turn ms: " << turn <<
+            ", scan ms: " << Milliseconds(phases[SCAN]) <<
+            ", task ms: " << Milliseconds(phases[TASK]) <<
+            ", paths: " << counters[PATHS_FOUND] << "/" << counters[PATHS_FOUND] + counters[PATHS_FAILED] <<
+            ", battles: " << counters[BATTLES] <<
+            ", objects: " << counters[OBJECTS]);
+}
+
+void AI::Profiler::Count(counter_t counter, uint32_t value)
+{
+    if (isEnabled()) counters[counter] += value;
+}
+
+AI::Profiler::Scope::Scope(phase_t p) : phase(p), active(isEnabled())
+{
+    if (active) start = std::chrono::steady_clock::now();
+}
+
+AI::Profiler::Scope::~Scope()
+{
+    if (active)
+        phases[phase] += std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - start).count();
+}
@@ -0,0 +1,67 @@
+/***************************************************************************
+ *   Copyright (C) 2012 by Andrey Afletdinov <fheroes2@gmail.com>          *
+ *                                                                         *
+ *   Part of the Free Heroes2 Engine:                                      *
+ *   http://sourceforge.net/projects/fheroes2                              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#pragma once
+
+#include <chrono>
+
+#include "types.h"
+
+namespace AI
+{
+    /* phase times and counters of one AI kingdom turn, written to the "ai profile" file;
+       nested phases are inclusive, path planning time is summed over the planning threads */
+    namespace Profiler
+    {
+        enum phase_t
+        {
+            SCAN, CASTLE, TASK, ADDED_TASK, PATH, BATTLE, PHASES
+        };
+
+        enum counter_t
+        {
+            PATHS_FOUND, PATHS_FAILED, BATTLES, OBJECTS, COUNTERS
+        };
+
+        bool isEnabled();
+
+        void BeginTurn();
+
+        void EndTurn(int color);
+
+        /* thread safe */
+        void Count(counter_t, uint32_t = 1);
+
+        class Scope
+        {
+        public:
+            explicit Scope(phase_t);
+
+            ~Scope();
+
+        private:
+            phase_t phase;
+            bool active;
+            std::chrono::steady_clock::time_point start;
+        };
+    }
+}
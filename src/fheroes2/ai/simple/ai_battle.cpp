@@ -39,6 +39,7 @@
 #include "battle_interface.h"
 #include "battle_command.h"
 #include "battle_army.h"
+#include "ai_battle_search.h"
 
 namespace Battle
 {
@@ -122,9 +123,7 @@ const Battle::Unit *Battle::AIGetEnemyAbroadMaxQuality(s32 position, int color)
     const Unit *res = nullptr;
     s32 quality = 0;
 
-    const Indexes around = Board::GetAroundIndexes(position);
-
-    for (int it : around)
+    for (const s32 it : Board::GetAroundSpan(position))
     {
         const Cell *cell = Board::GetCell(it);
         const Unit *enemy = cell ? cell->GetUnit() : nullptr;
@@ -232,6 +231,16 @@ using namespace Battle;
 
 void AI::BattleTurn(Arena &arena, const Unit &b, Actions &a)
 {
+    const Settings &conf = Settings::Get();
+
+    // search battle AI, the spells are still decided here
+    if (conf.BattleAIBudget() && !b.Modes(SP_BERSERKER))
+    {
+        if (BattleMagicTurn(arena, b, a, nullptr)) return; /* repeat turn: correct spell ability */
+        if (BattleSearchTurn(arena, b, a, BattleSearchLimits(conf.BattleAIBudget(), 0, conf.BattleAIThreads())))
+            return;
+    }
+
     Board *board = Arena::GetBoard();
 
     // reset quality param for board
@@ -260,7 +269,7 @@ void AI::BattleTurn(Arena &arena, const Unit &b, Actions &a)
         if (b.Modes(SP_BERSERKER))
         {
             const Indexes positions = board->GetNearestTroopIndexes(b.GetHeadIndex(), nullptr);
-            if (!positions.empty()) move = *Rand::Get(positions);
+            if (!positions.empty()) move = *Arena::GetAIRandom().Get(positions);
         } else
         {
             if (BattleMagicTurn(arena, b, a, nullptr)) return; /* repeat turn: correct spell ability */
@@ -514,7 +523,7 @@ bool AI::BattleMagicTurn(Arena &arena, const Unit &b, Actions &a, const Unit *en
             if (AIApplySpell(Spell::DEATHWAVE, nullptr, *hero, a)) return true;
         }
 
-        Unit *stats = *Rand::Get(enemies);
+        Unit *stats = *Arena::GetAIRandom().Get(enemies);
 
         if (AIApplySpell(Spell::LIGHTNINGBOLT, stats, *hero, a)) return true;
         if (AIApplySpell(Spell::ARROW, stats, *hero, a)) return true;
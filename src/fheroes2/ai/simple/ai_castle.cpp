@@ -31,6 +31,7 @@
 #include "race.h"
 #include "game.h"
 #include "ai_simple.h"
+#include "ai_profiler.h"
 
 void AICastleDefense(Castle &c)
 {
@@ -161,6 +162,8 @@ void AICastleDevelopment(Castle &c)
 
 void AICastleTurn(Castle *castle)
 {
+    AI::Profiler::Scope scope(AI::Profiler::CASTLE);
+
     if (castle) AI::CastleTurn(*castle);
 }
 
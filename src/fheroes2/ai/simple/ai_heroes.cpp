@@ -36,6 +36,9 @@
 #include "world.h"
 #include "game_interface.h"
 #include "ai_simple.h"
+#include "game_autoplay.h"
+#include "ai_profiler.h"
+#include "battle_estimator.h"
 #include "rand.h"
 
 #include <sstream>
@@ -165,6 +168,14 @@ bool AIHeroesPriorityObject(const Heroes &hero, s32 index)
     switch (tile.GetObject())
     {
         case MP2::OBJ_MONSTER:
+        {
+            // a detour only for the fights that cost little
+            Army enemy(tile);
+            return AI::HeroesValidObject(hero, index) &&
+                   (hero.GetArmy().m_troops.GetStrength() > 3 * enemy.m_troops.GetStrength() ||
+                    0.25 > Battle::Estimator().Get(hero.GetArmy(), enemy, index).losses);
+        }
+
         case MP2::OBJ_SAWMILL:
         case MP2::OBJ_MINES:
         case MP2::OBJ_ALCHEMYLAB:
@@ -292,6 +303,7 @@ void AIHeroesAddedRescueTask(Heroes &hero)
 
 void AIHeroesAddedTask(Heroes &hero)
 {
+    AI::Profiler::Scope scope(AI::Profiler::ADDED_TASK);
     AIHero &ai_hero = AIHeroes::Get(hero);
     AIKingdom &ai_kingdom = AIKingdoms::Get(hero.GetColor());
 
@@ -322,6 +334,8 @@ void AIHeroesAddedTask(Heroes &hero)
             if (tile.isWater() && MP2::OBJ_BOAT != tile.GetObject()) continue;
         }
 
+        if (!world.isReachableRegion(hero.GetIndex(), (*it).first)) continue;
+
         objs.emplace_back((*it).first,
                           Maps::GetApproximateDistance(hero.GetIndex(), (*it).first));
     }
@@ -329,22 +343,42 @@ void AIHeroesAddedTask(Heroes &hero)
 
     sort(objs.begin(), objs.end(), IndexDistance::Shortest);
 
-    for (vector<IndexDistance>::const_iterator
-                 it = objs.begin(); it != objs.end(); ++it)
+    // the paths of a batch are planned in parallel and taken in distance order
+    const size_t batch = 2 * HERO_MAX_SHEDULED_TASK;
+    s32 last = -1;
+
+    for (size_t first = 0; first < objs.size() && task.size() < HERO_MAX_SHEDULED_TASK; first += batch)
     {
-        if (task.size() >= HERO_MAX_SHEDULED_TASK) break;
-        const bool validobj = AI::HeroesValidObject(hero, (*it).first);
+        vector<s32> valids;
+
+        for (size_t ii = first; ii < objs.size() && ii < first + batch; ++ii)
+            if (AI::HeroesValidObject(hero, objs[ii].first))
+                valids.push_back(objs[ii].first);
+
+        vector<u8> reachable(valids.size(), 0);
 
-        if (validobj &&
-            hero.GetPath().Calculate((*it).first))
+        AIPlanParallel(valids.size(), [&](size_t ii)
         {
-            task.push_back((*it).first);
-            ai_objects.erase((*it).first);
-        } else
+            Route::Path path(hero);
+            reachable[ii] = path.Plan(valids[ii]);
+        });
+
+        for (size_t ii = 0; ii < valids.size() && task.size() < HERO_MAX_SHEDULED_TASK; ++ii)
         {
+            last = valids[ii];
+
+            if (reachable[ii])
+            {
+                task.push_back(valids[ii]);
+                ai_objects.erase(valids[ii]);
+            }
         }
     }
 
+    // the hero keeps the path of the last candidate, as with one search after another
+    if (0 <= last)
+        hero.GetPath().Calculate(last);
+
     if (task.empty())
         AIHeroesAddedRescueTask(hero);
 }
@@ -370,6 +404,7 @@ void AI::HeroesActionNewPosition(Heroes &hero)
 
 bool AI::HeroesGetTask(Heroes &hero)
 {
+    Profiler::Scope scope(Profiler::TASK);
     vector<s32> results;
     results.reserve(5);
 
@@ -605,6 +640,7 @@ void AIHeroesTurn(Heroes *hero)
 
 void AI::HeroesTurn(Heroes &hero)
 {
+    Game::Autoplay::Timer timer(Game::Autoplay::HERO);
     Interface::StatusWindow &status = Interface::Basic::Get().GetStatusWindow();
 
     while (hero.MayStillMove() &&
@@ -38,6 +38,7 @@
 #include "ai.h"
 #include "ai_simple.h"
 #include "mus.h"
+#include "ai_profiler.h"
 
 void AICastleTurn(Castle *);
 
@@ -70,54 +71,113 @@ void AIKingdom::Reset()
 {
     capital = nullptr;
     scans.clear();
+    objects.clear();
+    epoch = 0;
+    cursor = 0;
 }
 
 void IndexObjectMap::DumpObjects(const IndexDistance &id)
 {
 }
 
-void WorldStoreObjects(int color, IndexObjectMap &store)
+bool WorldStoreObject(int color, const Maps::Tiles &tile)
 {
-    for (s32 it = 0; it < world.w() * world.h(); ++it)
+    if (tile.isFog(color)) return false;
+
+    if (MP2::isGroundObject(tile.GetObject()) ||
+        MP2::isWaterObject(tile.GetObject()) || MP2::OBJ_HEROES == tile.GetObject())
     {
-        const Maps::Tiles &tile = world.GetTiles(it);
-        if (tile.isFog(color)) continue;
+        // if quantity object is empty
+        if (MP2::isQuantityObject(tile.GetObject()) &&
+            !MP2::isPickupObject(tile.GetObject()) && !tile.QuantityIsValid())
+            return false;
+
+        // skip captured obj
+        if (MP2::isCaptureObject(tile.GetObject()) &&
+            Players::isFriends(color, tile.QuantityColor()))
+            return false;
+
+        // skip for meeting heroes
+        if (MP2::OBJ_HEROES == tile.GetObject())
+        {
+            const Heroes *hero = tile.GetHeroes();
+            if (hero && color == hero->GetColor()) return false;
+        }
 
-        if (MP2::isGroundObject(tile.GetObject()) ||
-            MP2::isWaterObject(tile.GetObject()) || MP2::OBJ_HEROES == tile.GetObject())
+        // check: is visited objects
+        switch (tile.GetObject())
         {
-            // if quantity object is empty
-            if (MP2::isQuantityObject(tile.GetObject()) &&
-                !MP2::isPickupObject(tile.GetObject()) && !tile.QuantityIsValid())
-                continue;
+            case MP2::OBJ_MAGELLANMAPS:
+            case MP2::OBJ_OBSERVATIONTOWER:
+                if (world.GetKingdom(color).isVisited(tile)) return false;
+                break;
+
+            default:
+                break;
+        }
+
+        return true;
+    }
+
+    return false;
+}
+
+void WorldStoreObjects(int color, IndexObjectMap &store)
+{
+    // rows scanned in parallel, stored in map order
+    vector<vector<s32>> rows(world.h());
+    const Maps::TilesHot &hot = world.hot_tiles;
 
-            // skip captured obj
-            if (MP2::isCaptureObject(tile.GetObject()) &&
-                Players::isFriends(color, tile.QuantityColor()))
+    AIPlanParallel(rows.size(), [&](size_t row)
+    {
+        for (s32 it = row * world.w(); it < static_cast<s32>(row + 1) * world.w(); ++it)
+        {
+            // the packed arrays skip the empty and fogged tiles
+            if (MP2::OBJ_ZERO == hot.objects[it] || (hot.fogs[it] & color) == color)
                 continue;
 
-            // skip for meeting heroes
-            if (MP2::OBJ_HEROES == tile.GetObject())
-            {
-                const Heroes *hero = tile.GetHeroes();
-                if (hero && color == hero->GetColor()) continue;
-            }
+            if (WorldStoreObject(color, world.GetTiles(it)))
+                rows[row].push_back(it);
+        }
+    });
 
-            // check: is visited objects
-            switch (tile.GetObject())
-            {
-                case MP2::OBJ_MAGELLANMAPS:
-                case MP2::OBJ_OBSERVATIONTOWER:
-                    if (world.GetKingdom(color).isVisited(tile)) continue;
-                    break;
+    for (const auto &row : rows)
+        for (s32 it : row)
+            store[it] = world.GetTiles(it).GetObject();
+}
 
-                default:
-                    break;
-            }
+/* the changed tiles since the last turn, or the whole map after a new epoch */
+void WorldUpdateObjects(int color, AIKingdom &ai)
+{
+    AI::Profiler::Scope scope(AI::Profiler::SCAN);
+    const MapsIndexes &changes = world.GetChangedTiles();
+
+    if (ai.epoch != world.GetChangedEpoch())
+    {
+        ai.objects.clear();
+        WorldStoreObjects(color, ai.objects);
+        AI::Profiler::Count(AI::Profiler::OBJECTS, world.w() * world.h());
+    } else
+    {
+        vector<s32> tiles(changes.begin() + ai.cursor, changes.end());
+
+        sort(tiles.begin(), tiles.end());
+        tiles.erase(unique(tiles.begin(), tiles.end()), tiles.end());
+        AI::Profiler::Count(AI::Profiler::OBJECTS, tiles.size());
+
+        for (s32 it : tiles)
+        {
+            const Maps::Tiles &tile = world.GetTiles(it);
 
-            store[it] = tile.GetObject();
+            if (WorldStoreObject(color, tile))
+                ai.objects[it] = tile.GetObject();
+            else
+                ai.objects.erase(it);
         }
     }
+
+    ai.epoch = world.GetChangedEpoch();
+    ai.cursor = changes.size();
 }
 
 void AI::KingdomTurn(Kingdom &kingdom)
@@ -133,6 +193,8 @@ void AI::KingdomTurn(Kingdom &kingdom)
         return;
     }
 
+    AI::Profiler::BeginTurn();
+
     if (!Settings::Get().MusicMIDI()) AGG::PlayMusic(MUS::COMPUTER);
 
     Interface::StatusWindow &status = Interface::Basic::Get().GetStatusWindow();
@@ -142,8 +204,8 @@ void AI::KingdomTurn(Kingdom &kingdom)
     status.RedrawTurnProgress(0);
 
     // scan map
-    ai.scans.clear();
-    WorldStoreObjects(color, ai.scans);
+    WorldUpdateObjects(color, ai);
+    ai.scans = ai.objects;
 
     // set capital
     if (nullptr == ai.capital && !castles.empty())
@@ -280,4 +342,6 @@ void AI::KingdomTurn(Kingdom &kingdom)
 
     // turn indicator
     status.RedrawTurnProgress(9);
+
+    AI::Profiler::EndTurn(color);
 }
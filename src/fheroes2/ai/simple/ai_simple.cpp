@@ -28,8 +28,14 @@
  *******************************************************************************/
 
 #include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
 #include "heroes.h"
 #include "castle.h"
+#include "settings.h"
 #include "ai_simple.h"
 
 const char *AI::Type()
@@ -75,3 +81,125 @@ bool Queue::isPresent(s32 index) const
 {
     return end() != find(begin(), end(), index);
 }
+
+namespace
+{
+    /* the planning threads, kept for the whole game; the calling thread works too */
+    class AIPlanPool
+    {
+    public:
+        AIPlanPool() : work(nullptr), count(0), next(0), generation(0), busy(0), stop(false)
+        {}
+
+        ~AIPlanPool()
+        {
+            Stop();
+        }
+
+        /* with the caller, threads in total */
+        void Resize(uint32_t threads)
+        {
+            if (workers.size() + 1 == threads) return;
+
+            Stop();
+
+            for (uint32_t ii = 1; ii < threads; ++ii)
+                workers.emplace_back(&AIPlanPool::Worker, this, generation);
+        }
+
+        void Run(size_t size, const function<void(size_t)> &job)
+        {
+            {
+                lock_guard<mutex> lock(guard);
+                work = &job;
+                count = size;
+                next = 0;
+                busy = workers.size();
+                ++generation;
+            }
+
+            wake.notify_all();
+            Drain();
+
+            unique_lock<mutex> lock(guard);
+            done.wait(lock, [this]()
+            { return 0 == busy; });
+            work = nullptr;
+        }
+
+    private:
+        void Drain()
+        {
+            for (size_t ii = next++; ii < count; ii = next++)
+                (*work)(ii);
+        }
+
+        void Worker(uint32_t seen)
+        {
+            unique_lock<mutex> lock(guard);
+
+            while (true)
+            {
+                wake.wait(lock, [this, seen]()
+                { return stop || generation != seen; });
+
+                if (stop) return;
+
+                seen = generation;
+                lock.unlock();
+                Drain();
+                lock.lock();
+
+                if (0 == --busy) done.notify_one();
+            }
+        }
+
+        void Stop()
+        {
+            {
+                lock_guard<mutex> lock(guard);
+                stop = true;
+            }
+
+            wake.notify_all();
+
+            for (auto &it : workers)
+                it.join();
+
+            workers.clear();
+            stop = false;
+        }
+
+        vector<thread> workers;
+        mutex guard;
+        condition_variable wake;
+        condition_variable done;
+        const function<void(size_t)> *work;
+        size_t count;
+        atomic<size_t> next;
+        uint32_t generation;
+        size_t busy;
+        bool stop;
+    };
+}
+
+void AIPlanParallel(size_t count, const function<void(size_t)> &work)
+{
+    static AIPlanPool pool;
+
+    uint32_t threads = Settings::Get().AIThreads();
+
+    if (0 == threads)
+        threads = max(1u, thread::hardware_concurrency());
+
+    // a short scan costs less on the caller than waking the pool
+    if (1 >= threads || count < 2 * threads)
+    {
+        for (size_t ii = 0; ii < count; ++ii)
+            work(ii);
+        return;
+    }
+
+    pool.Resize(threads);
+    pool.Run(count, work);
+}
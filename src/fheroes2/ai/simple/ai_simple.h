@@ -32,6 +32,7 @@
 #include <map>
 #include <list>
 #include <vector>
+#include <functional>
 
 #include "pairs.h"
 #include "ai.h"
@@ -43,13 +44,18 @@ struct IndexObjectMap : map<s32, int>
 
 struct AIKingdom
 {
-    AIKingdom() : capital(nullptr)
+    AIKingdom() : capital(nullptr), epoch(0), cursor(0)
     {};
 
     void Reset();
 
     Castle *capital;
     IndexObjectMap scans;
+
+    // known objects, kept up to date from the world tile changes
+    IndexObjectMap objects;
+    uint32_t epoch;
+    size_t cursor;
 };
 
 class AIKingdoms : public vector<AIKingdom>
@@ -98,3 +104,8 @@ private:
     AIHeroes() : vector<AIHero>(HEROESMAXCOUNT + 2)
     {};
 };
+
+/* planning phase: work(ii) for every ii < count on the AI threads; work may only read the world
+   and write its own slot, the caller commits the results in order. The threads are started once
+   and wait between the calls */
+void AIPlanParallel(size_t count, const function<void(size_t)> &work);
@@ -331,42 +331,17 @@ uint32_t Troops::GetUniqueCount() const
 
 uint32_t Troops::GetAttack() const
 {
-    uint32_t res = 0;
-    uint32_t count = 0;
-
-    for (auto _item : _items)
-        if (_item->isValid())
-        {
-            res += static_cast<Monster *>(_item.get())->GetAttack();
-            ++count;
-        }
-
-    return count ? res / count : 0;
+    return GetSummary().attack;
 }
 
 uint32_t Troops::GetDefense() const
 {
-    uint32_t res = 0;
-    uint32_t count = 0;
-
-    for (auto _item : _items)
-        if (_item->isValid())
-        {
-            res += static_cast<Monster *>(_item.get())->GetDefense();
-            ++count;
-        }
-
-    return count ? res / count : 0;
+    return GetSummary().defense;
 }
 
 uint32_t Troops::GetHitPoints() const
 {
-    uint32_t res = 0;
-
-    for (auto _item : _items)
-        if (_item->isValid()) res += _item->GetHitPointsTroop();
-
-    return res;
+    return GetSummary().hitpoints;
 }
 
 uint32_t Troops::GetDamageMin() const
@@ -401,12 +376,45 @@ uint32_t Troops::GetDamageMax() const
 
 uint32_t Troops::GetStrength() const
 {
-    uint32_t res = 0;
+    return GetSummary().strength;
+}
 
-    for (auto _item : _items)
-        if (_item->isValid()) res += _item->GetStrength();
+const Troops::Summary &Troops::GetSummary() const
+{
+    bool actual = summary.slots.size() == _items.size();
 
-    return res;
+    for (size_t ii = 0; actual && ii < _items.size(); ++ii)
+        actual = summary.slots[ii].first == _items[ii]->GetID() &&
+                 summary.slots[ii].second == _items[ii]->GetCount();
+
+    if (actual)
+        return summary;
+
+    uint32_t count = 0;
+    summary = Summary();
+    summary.slots.reserve(_items.size());
+
+    for (const auto &_item : _items)
+    {
+        summary.slots.emplace_back(_item->GetID(), _item->GetCount());
+
+        if (!_item->isValid())
+            continue;
+
+        summary.strength += _item->GetStrength();
+        summary.hitpoints += _item->GetHitPointsTroop();
+        summary.attack += static_cast<const Monster &>(*_item).GetAttack();
+        summary.defense += static_cast<const Monster &>(*_item).GetDefense();
+        ++count;
+    }
+
+    if (count)
+    {
+        summary.attack /= count;
+        summary.defense /= count;
+    }
+
+    return summary;
 }
 
 void Troops::Clean()
@@ -121,6 +121,24 @@ public:
     void SplitTroopIntoFreeSlots(const Troop &, uint32_t);
 
     vector<sp<Troop>> _items;
+
+private:
+    /* sums over the slots, counted again when a slot monster or count differs from the last query */
+    struct Summary
+    {
+        Summary() : strength(0), hitpoints(0), attack(0), defense(0)
+        {}
+
+        vector<pair<int, uint32_t>> slots; // monster, count
+        uint32_t strength;
+        uint32_t hitpoints;
+        uint32_t attack;
+        uint32_t defense;
+    };
+
+    const Summary &GetSummary() const;
+
+    mutable Summary summary;
 };
 
 enum
@@ -449,9 +449,7 @@ Battle::TargetsInfo Battle::Arena::GetTargetsForDamage(Unit &attacker, Unit &def
     if ((attacker.GetID() == Monster::LICH ||
          attacker.GetID() == Monster::POWER_LICH) && !attacker.isHandFighting())
     {
-        const Indexes around = Board::GetAroundIndexes(defender.GetHeadIndex());
-
-        for (int it : around)
+        for (const s32 it : Board::GetAroundSpan(defender.GetHeadIndex()))
         {
             if (nullptr != (enemy = Board::GetCell(it)->GetUnit()) && enemy != &defender)
             {
@@ -527,7 +525,7 @@ Battle::TargetsInfo Battle::Arena::GetTargetsForSpells(const HeroBase *hero, con
                 {
                     const Indexes reslt = board.GetNearestTroopIndexes(dst, &trgts);
                     if (reslt.empty()) break;
-                    trgts.push_back(reslt.size() > 1 ? *Rand::Get(reslt) : reslt.front());
+                    trgts.push_back(reslt.size() > 1 ? *Arena::GetRandom().Get(reslt) : reslt.front());
                 }
 
                 // save targets
@@ -610,7 +608,7 @@ Battle::TargetsInfo Battle::Arena::GetTargetsForSpells(const HeroBase *hero, con
     {
         const uint32_t resist = (*it).defender->GetMagicResist(spell, hero ? hero->GetPower() : 0);
 
-        if (0 < resist && 100 > resist && resist >= Rand::Get(1, 100))
+        if (0 < resist && 100 > resist && resist >= Arena::GetRandom().Get(1, 100))
         {
             if (interface) interface->RedrawActionResistSpell(*(*it).defender);
 
@@ -728,13 +726,13 @@ void Battle::Arena::ApplyActionSpellEarthQuake(Command &cmd)
     // FIXME: Arena::ApplyActionSpellEarthQuake: check hero spell power
 
     // apply random damage
-    if (0 != board[8].GetObject()) board[8].SetObject(Rand::Get(board[8].GetObject()));
-    if (0 != board[29].GetObject()) board[29].SetObject(Rand::Get(board[29].GetObject()));
-    if (0 != board[73].GetObject()) board[73].SetObject(Rand::Get(board[73].GetObject()));
-    if (0 != board[96].GetObject()) board[96].SetObject(Rand::Get(board[96].GetObject()));
+    if (0 != board[8].GetObject()) board[8].SetObject(Arena::GetRandom().Get(board[8].GetObject()));
+    if (0 != board[29].GetObject()) board[29].SetObject(Arena::GetRandom().Get(board[29].GetObject()));
+    if (0 != board[73].GetObject()) board[73].SetObject(Arena::GetRandom().Get(board[73].GetObject()));
+    if (0 != board[96].GetObject()) board[96].SetObject(Arena::GetRandom().Get(board[96].GetObject()));
 
-    if (towers[0] && towers[0]->isValid() && Rand::Get(1)) towers[0]->SetDestroy();
-    if (towers[2] && towers[2]->isValid() && Rand::Get(1)) towers[2]->SetDestroy();
+    if (towers[0] && towers[0]->isValid() && Arena::GetRandom().Get(1)) towers[0]->SetDestroy();
+    if (towers[2] && towers[2]->isValid() && Arena::GetRandom().Get(1)) towers[2]->SetDestroy();
 
 }
 
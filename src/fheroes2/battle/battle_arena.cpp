@@ -37,6 +37,7 @@
 #include "battle_bridge.h"
 #include "battle_interface.h"
 #include "battle_command.h"
+#include "battle_replay.h"
 #include "localevent.h"
 #include "tools.h"
 #include "m82.h"
@@ -49,10 +50,11 @@
 
 namespace Battle
 {
-    Arena *arena = nullptr;
+    // one arena per thread, see Battle::Simulator
+    thread_local Arena *arena = nullptr;
 }
 
-int GetCovr(int ground)
+int GetCovr(int ground, Rand::Stream &random)
 {
     vector<int> covrs;
 
@@ -98,7 +100,7 @@ int GetCovr(int ground)
             break;
     }
 
-    return covrs.empty() ? ICN::UNKNOWN : *Rand::Get(covrs);
+    return covrs.empty() ? ICN::UNKNOWN : *random.Get(covrs);
 }
 
 ByteVectorWriter &Battle::operator<<(ByteVectorWriter &msg, const TargetInfo &t)
@@ -173,6 +175,16 @@ Battle::Graveyard *Battle::Arena::GetGraveyard()
     return &arena->graveyard;
 }
 
+Rand::Stream &Battle::Arena::GetRandom()
+{
+    return arena->random;
+}
+
+Rand::Stream &Battle::Arena::GetAIRandom()
+{
+    return arena->ai_random;
+}
+
 Battle::Interface *Battle::Arena::GetInterface()
 {
     return arena->interface.get();
@@ -194,9 +206,10 @@ Battle::Tower *Battle::Arena::GetTower(int type)
     return nullptr;
 }
 
-Battle::Arena::Arena(Army &a1, Army &a2, s32 index, bool local) :
+Battle::Arena::Arena(Army &a1, Army &a2, s32 index, bool local, uint32_t seed) :
         army1(nullptr), army2(nullptr), armies_order(nullptr), castle(nullptr), current_color(0), catapult(nullptr),
-        bridge(nullptr), interface(nullptr), icn_covr(ICN::UNKNOWN), current_turn(0), auto_battle(0), end_turn(false)
+        bridge(nullptr), interface(nullptr), icn_covr(ICN::UNKNOWN), random(seed), ai_random(~seed), uniq(0), replay(nullptr),
+        current_turn(0), auto_battle(0), end_turn(false)
 {
     const Settings &conf = Settings::Get();
     auto_battle = conf.QuickCombat();
@@ -206,8 +219,11 @@ Battle::Arena::Arena(Army &a1, Army &a2, s32 index, bool local) :
     army1 = make_unique<Force>(a1, false);
     army2 = make_unique<Force>(a2, true);
 
+    // open field without map tile: no castle, no obstacles
+    const bool field = !Maps::isValidAbsIndex(index);
+
     // init castle (interface ahead)
-    castle = world.GetCastle(Maps::GetPoint(index));
+    castle = field ? nullptr : world.GetCastle(Maps::GetPoint(index));
 
     if (castle)
     {
@@ -226,9 +242,6 @@ Battle::Arena::Arena(Army &a1, Army &a2, s32 index, bool local) :
         interface = std::make_unique<Interface>(*this, index);
         board.SetArea(interface->GetArea());
 
-        for_each(army1->begin(), army1->end(), mem_fun(&Unit::InitContours));
-        for_each(army2->begin(), army2->end(), mem_fun(&Unit::InitContours));
-
         if (conf.Sound())
             AGG::PlaySound(M82::PREBATTL);
 
@@ -278,13 +291,13 @@ Battle::Arena::Arena(Army &a1, Army &a2, s32 index, bool local) :
         // bridge
         board[49].SetObject(1);
         board[50].SetObject(1);
-    } else
+    } else if (!field)
         // set obstacles
     {
         MapsIndexes mapIndexes;
         Maps::ScanAroundObject(index, MP2::OBJ_CRATER, mapIndexes);
         icn_covr = !mapIndexes.empty() ?
-                   GetCovr(world.GetTiles(index).GetGround()) : ICN::UNKNOWN;
+                   GetCovr(world.GetTiles(index).GetGround(), random) : ICN::UNKNOWN;
 
         if (icn_covr != ICN::UNKNOWN)
             board.SetCovrObjects(icn_covr);
@@ -294,7 +307,7 @@ Battle::Arena::Arena(Army &a1, Army &a2, s32 index, bool local) :
 
     // set guardian objects mode (+2 defense)
     if (conf.ExtWorldGuardianObjectsTwoDefense() &&
-        !castle &&
+        !castle && !field &&
         MP2::isCaptureObject(world.GetTiles(index).GetObject(false)))
         army2->SetModes(ARMY_GUARDIANS_OBJECT);
 
@@ -321,6 +334,7 @@ Battle::Arena::Arena(Army &a1, Army &a2, s32 index, bool local) :
 
 Battle::Arena::~Arena()
 {
+    delete bridge;
 }
 
 void Battle::Arena::TurnTroop(Unit *current_troop)
@@ -338,7 +352,11 @@ void Battle::Arena::TurnTroop(Unit *current_troop)
         } else
         {
             // turn opponents
-            if (current_troop->isControlRemote())
+            if (replay && replay->isPlayback())
+            {
+                if (!replay->NextActions(actions))
+                    end_turn = true;
+            } else if (current_troop->isControlRemote())
                 RemoteTurn(*current_troop, actions);
             else
             {
@@ -349,6 +367,9 @@ void Battle::Arena::TurnTroop(Unit *current_troop)
                 } else if (current_troop->isControlHuman())
                     HumanTurn(*current_troop, actions);
             }
+
+            if (replay && !replay->isPlayback())
+                replay->Record(actions);
         }
 
         // apply task
@@ -383,14 +404,16 @@ void Battle::Arena::TurnTroop(Unit *current_troop)
 
         board.Reset();
 
-        DELAY(10);
+        // pace only the battles shown on screen
+        if (interface && !Interface::isTurboMode()) DELAY(10);
     }
 }
 
 bool Battle::Arena::BattleValid() const
 {
     return army1->isValid() && army2->isValid() &&
-           0 == result_game.army1 && 0 == result_game.army2;
+           0 == result_game.army1 && 0 == result_game.army2 &&
+           !(replay && replay->isExhausted());
 }
 
 void Battle::Arena::Turns()
@@ -1013,7 +1036,6 @@ Battle::Unit *Battle::Arena::CreateElemental(const Spell &spell)
     {
         elem->SetModes(CAP_SUMMONELEM);
         elem->SetArmy(hero->GetArmy());
-        if (interface) elem->InitContours();
         army.push_back(elem);
     } else
     {
@@ -1030,7 +1052,6 @@ Battle::Unit *Battle::Arena::CreateMirrorImage(Unit &b, s32 pos)
     image->SetArmy(*b.GetArmy());
     image->SetMirror(&b);
     image->SetModes(CAP_MIRRORIMAGE);
-    if (interface) image->InitContours();
     b.SetModes(CAP_MIRROROWNER);
 
     GetCurrentForce().push_back(image);
@@ -1194,3 +1215,18 @@ void Battle::Arena::BreakAutoBattle()
 {
     auto_battle &= ~current_color;
 }
+
+void Battle::Arena::SetAutoBattle(int colors)
+{
+    auto_battle = colors;
+}
+
+void Battle::Arena::SetReplay(Replay *rp)
+{
+    replay = rp;
+}
+
+uint32_t Battle::Arena::GetUniq()
+{
+    return ++uniq;
+}
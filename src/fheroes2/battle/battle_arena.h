@@ -30,13 +30,10 @@
 #include "gamedefs.h"
 #include "ai.h"
 #include "spell_storage.h"
+#include "rand.h"
 #include "battle_board.h"
 #include "battle_grave.h"
 
-#define ARENAW 11
-#define ARENAH 9
-#define ARENASIZE ARENAW * ARENAH
-
 class Castle;
 
 class HeroBase;
@@ -51,6 +48,10 @@ namespace Battle
 
     class Command;
 
+    class Replay;
+
+    struct State;
+
     class Actions : public list<Command>
     {
     public:
@@ -60,7 +61,7 @@ namespace Battle
     class Arena
     {
     public:
-        Arena(Army &, Army &, s32, bool);
+        Arena(Army &, Army &, s32, bool, uint32_t seed);
 
         ~Arena();
 
@@ -74,6 +75,10 @@ namespace Battle
 
         void BreakAutoBattle();
 
+        void SetAutoBattle(int colors);
+
+        void SetReplay(Replay *);
+
         uint32_t GetCurrentTurn() const;
 
         Result &GetResult();
@@ -161,6 +166,8 @@ namespace Battle
 
         uint32_t GetCastleTargetValue(int) const;
 
+        uint32_t GetUniq();
+
         static Board *GetBoard();
 
         static Tower *GetTower(int);
@@ -173,11 +180,17 @@ namespace Battle
 
         static Graveyard *GetGraveyard();
 
+        static Rand::Stream &GetRandom();
+
+        static Rand::Stream &GetAIRandom();
+
     private:
         friend ByteVectorWriter &operator<<(ByteVectorWriter &, const Arena &);
         
         friend ByteVectorReader &operator>>(ByteVectorReader &, Arena &);
 
+        friend struct State;
+
         void RemoteTurn(const Unit &, Actions &);
 
         void HumanTurn(const Unit &, Actions &);
@@ -245,6 +258,18 @@ namespace Battle
         Board board;
         int icn_covr;
 
+        // everything that decides the battle, the animations draw from Rand::Cosmetic
+        Rand::Stream random;
+
+        // the AI decisions, a replay does not call the AI and must not miss its draws
+        Rand::Stream ai_random;
+
+        // unit uids, the same for every run of a battle
+        uint32_t uniq;
+
+        // records the decisions or plays them back
+        Replay *replay;
+
         uint32_t current_turn;
         int auto_battle;
 
@@ -419,7 +419,7 @@ bool Battle::Force::SetIdleAnimation()
         {
             if (unit.isFinishAnimFrame())
                 unit.ResetAnimFrame(AS_IDLE);
-            else if (unit.isStartAnimFrame() && 3 > Rand::Get(1, 10))
+            else if (unit.isStartAnimFrame() && 3 > Rand::Cosmetic().Get(1, 10))
             {
                 unit.IncreaseAnimFrame();
                 res = true;
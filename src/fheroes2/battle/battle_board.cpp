@@ -20,8 +20,6 @@
  *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
  ***************************************************************************/
 
-#include <set>
-#include <iterator>
 #include <functional>
 #include <algorithm>
 #include "world.h"
@@ -32,7 +30,6 @@
 #include "battle_troop.h"
 #include "game_static.h"
 #include "icn.h"
-#include <unordered_map>
 #include "rand.h"
 #include <sstream>
 #include "battle_army.h"
@@ -41,7 +38,7 @@ namespace Battle
 {
     int GetObstaclePosition()
     {
-        return Rand::Get(3, 6) + (11 * Rand::Get(1, 7));
+        return Arena::GetRandom().Get(3, 6) + (11 * Arena::GetRandom().Get(1, 7));
     }
 
     bool WideDifficultDirection(int where, int whereto)
@@ -128,12 +125,7 @@ void Battle::Board::SetEnemyQuality(const Unit &b)
 
 s32 Battle::Board::GetDistance(s32 index1, s32 index2)
 {
-    if (!isValidIndex(index1) || !isValidIndex(index2))
-        return 0;
-    const s32 dx = (index1 % ARENAW) - (index2 % ARENAW);
-    const s32 dy = (index1 / ARENAW) - (index2 / ARENAW);
-
-    return Sign(dx) == Sign(dy) ? max(abs(dx), abs(dy)) : abs(dx) + abs(dy);
+    return isValidIndex(index1) && isValidIndex(index2) ? hexGeometry.distance[index1][index2] : 0;
 }
 
 void Battle::Board::SetScanPassability(const Unit &b)
@@ -162,70 +154,94 @@ struct bcell_t
 {
     s32 cost;
     s32 prnt;
+    int from; // direction back to the parent
     bool open;
 
-    bcell_t() : cost(MAXU16), prnt(-1), open(true)
+    bcell_t() : cost(MAXU16), prnt(-1), from(Battle::UNKNOWN), open(true)
     {}
 };
 
+typedef pair<s32, s32> bopen_t; // cost, index
+
+// path searches on this thread, for the benchmarks
+static thread_local uint32_t astarQueries = 0;
+
+uint32_t Battle::Board::GetAStarQueries()
+{
+    return astarQueries;
+}
+
 Battle::Indexes Battle::Board::GetAStarPath(const Unit &b, const Position &dst, bool debug)
 {
     const Castle *castle = Arena::GetCastle();
     const Bridge *bridge = Arena::GetBridge();
-    unordered_map<s32, bcell_t> listCells;
+    const bool moat = castle && castle->isBuild(BUILD_MOAT);
+    const s32 target = dst.GetHead()->GetIndex();
+
+    ++astarQueries;
+
+    // every cell is relaxed at most once from each neighbour
+    bcell_t listCells[ARENASIZE];
+    bopen_t opens[6 * ARENASIZE];
+    size_t opensSize = 0;
     s32 cur = b.GetHeadIndex();
 
     listCells[cur].prnt = -1;
     listCells[cur].cost = 0;
     listCells[cur].open = false;
 
-
-    while (cur != dst.GetHead()->GetIndex())
+    while (cur != target)
     {
         const Cell &center = at(cur);
-        Indexes around = b.isWide() ?
-                         GetMoveWideIndexes(cur,
-                                            (0 > listCells[cur].prnt ? b.isReflect() : (RIGHT_SIDE & GetDirection(cur,
-                                                                                                                  listCells[cur].prnt))))
-                                    :
-                         GetAroundIndexes(cur);
-
-        for (auto it = around.begin(); it != around.end(); ++it)
+        const IndexSpan around = b.isWide() ?
+                                 GetMoveWideSpan(cur, 0 > listCells[cur].prnt ? b.isReflect() : (RIGHT_SIDE & listCells[cur].from))
+                                            : GetAroundSpan(cur);
+
+        for (const s32 index : around)
         {
-            Cell &cell = at(*it);
+            bcell_t &node = listCells[index];
+            const Cell &cell = at(index);
 
-            if (!listCells[*it].open || !cell.isPassable4(b, center) ||
-                (bridge && isBridgeIndex(*it)) && !bridge->isPassable(b.GetColor()))
+            if (!node.open || !cell.isPassable4(b, center) ||
+                (bridge && isBridgeIndex(index) && !bridge->isPassable(b.GetColor())))
                 continue;
-            const s32 cost = 100 * GetDistance(*it, dst.GetHead()->GetIndex()) +
-                             (b.isWide() && WideDifficultDirection(center.GetDirection(), GetDirection(*it, cur))
+            const int from = hexGeometry.direction[index][cur];
+            const s32 cost = 100 * hexGeometry.distance[index][target] +
+                             (b.isWide() && WideDifficultDirection(center.GetDirection(), from)
                               ? 100 : 0) +
-                             (castle && castle->isBuild(BUILD_MOAT) && isMoatIndex(*it) ? 100 : 0);
+                             (moat && isMoatIndex(index) ? 100 : 0);
 
-            // new cell
-            if (0 > listCells[*it].prnt)
-            {
-                listCells[*it].prnt = cur;
-                listCells[*it].cost = cost + listCells[cur].cost;
-            } else
-                // change parent
-            if (listCells[*it].cost > cost + listCells[cur].cost)
+            // new cell or change parent
+            if (0 > node.prnt || node.cost > cost + listCells[cur].cost)
             {
-                listCells[*it].prnt = cur;
-                listCells[*it].cost = cost + listCells[cur].cost;
+                node.prnt = cur;
+                node.from = from;
+                node.cost = cost + listCells[cur].cost;
+
+                opens[opensSize++] = bopen_t(node.cost, index);
+                push_heap(opens, opens + opensSize, greater<bopen_t>());
             }
         }
 
         listCells[cur].open = false;
         s32 cost = MAXU16;
 
-        // find min cost opens
-        for (auto it = listCells.begin(); it != listCells.end(); ++it)
-            if ((*it).second.open && cost > (*it).second.cost)
+        // find min cost opens, skip the outdated entries
+        while (opensSize)
+        {
+            pop_heap(opens, opens + opensSize, greater<bopen_t>());
+            const bopen_t &top = opens[--opensSize];
+
+            if (!listCells[top.second].open || listCells[top.second].cost != top.first)
+                continue;
+
+            if (cost > top.first)
             {
-                cur = (*it).first;
-                cost = (*it).second.cost;
+                cur = top.second;
+                cost = top.first;
             }
+            break;
+        }
 
         if (MAXU16 == cost) break;
     }
@@ -368,17 +384,7 @@ Battle::Indexes Battle::Board::GetNearestTroopIndexes(s32 pos, const Indexes *bl
 
 int Battle::Board::GetDirection(s32 index1, s32 index2)
 {
-    if (!isValidIndex(index1) || !isValidIndex(index2))
-    {
-        return UNKNOWN;
-    }
-    if (index1 == index2) return CENTER;
-    for (direction_t dir = TOP_LEFT; dir < CENTER; ++dir)
-        if (isValidDirection(index1, dir) &&
-            index2 == GetIndexDirection(index1, dir))
-            return dir;
-
-    return UNKNOWN;
+    return isValidIndex(index1) && isValidIndex(index2) ? hexGeometry.direction[index1][index2] : static_cast<int>(UNKNOWN);
 }
 
 bool Battle::Board::isNearIndexes(s32 index1, s32 index2)
@@ -427,33 +433,8 @@ bool Battle::Board::isReflectDirection(int d)
 
 bool Battle::Board::isValidDirection(s32 index, int dir)
 {
-    if (isValidIndex(index))
-    {
-        const s32 x = index % ARENAW;
-        const s32 y = index / ARENAW;
-
-        switch (dir)
-        {
-            case CENTER:
-                return true;
-            case TOP_LEFT:
-                return !(0 == y || (0 == x && (y % 2)));
-            case TOP_RIGHT:
-                return !(0 == y || ((ARENAW - 1) == x && !(y % 2)));
-            case LEFT:
-                return !(0 == x);
-            case RIGHT:
-                return !((ARENAW - 1) == x);
-            case BOTTOM_LEFT:
-                return !((ARENAH - 1) == y || (0 == x && (y % 2)));
-            case BOTTOM_RIGHT:
-                return !((ARENAH - 1) == y || ((ARENAW - 1) == x && !(y % 2)));
-            default:
-                break;
-        }
-    }
-
-    return false;
+    return isValidIndex(index) &&
+           (CENTER == dir || (0 <= HexMath::DirectionSlot(dir) && (hexGeometry.mask[index] & dir)));
 }
 
 s32 Battle::Board::GetIndexDirection(s32 index, int dir)
@@ -462,29 +443,10 @@ s32 Battle::Board::GetIndexDirection(s32 index, int dir)
     {
         return -1;
     }
-    const s32 y = index / ARENAW;
-
-    switch (dir)
-    {
-        case CENTER:
-            return index;
-        case TOP_LEFT:
-            return index - ((y % 2) ? ARENAW + 1 : ARENAW);
-        case TOP_RIGHT:
-            return index - ((y % 2) ? ARENAW : ARENAW - 1);
-        case LEFT:
-            return index - 1;
-        case RIGHT:
-            return index + 1;
-        case BOTTOM_LEFT:
-            return index + ((y % 2) ? ARENAW - 1 : ARENAW);
-        case BOTTOM_RIGHT:
-            return index + ((y % 2) ? ARENAW : ARENAW + 1);
-        default:
-            break;
-    }
+    const int slot = HexMath::DirectionSlot(dir);
 
-    return -1;
+    // as before, an index off the board is not checked here
+    return CENTER == dir ? index : 0 <= slot ? HexMath::SlotIndex(index, slot) : -1;
 }
 
 s32 Battle::Board::GetIndexAbsPosition(const Point &pt) const
@@ -644,19 +606,19 @@ void Battle::Board::SetCobjObjects(const Maps::Tiles &tile)
                 break;
         }
 
-    if (!objs.empty() && 2 < Rand::Get(1, 10))
+    if (!objs.empty() && 2 < Arena::GetRandom().Get(1, 10))
     {
         // 80% 1 obj
         s32 dst = GetObstaclePosition();
-        SetCobjObject(*Rand::Get(objs), dst);
+        SetCobjObject(*Arena::GetRandom().Get(objs), dst);
 
         // 50% 2 obj
         while (at(dst).GetObject()) dst = GetObstaclePosition();
-        if (objs.size() > 1 && 5 < Rand::Get(1, 10)) SetCobjObject(*Rand::Get(objs), dst);
+        if (objs.size() > 1 && 5 < Arena::GetRandom().Get(1, 10)) SetCobjObject(*Arena::GetRandom().Get(objs), dst);
 
         // 30% 3 obj
         while (at(dst).GetObject()) dst = GetObstaclePosition();
-        if (objs.size() > 1 && 7 < Rand::Get(1, 10)) SetCobjObject(*Rand::Get(objs), dst);
+        if (objs.size() > 1 && 7 < Arena::GetRandom().Get(1, 10)) SetCobjObject(*Arena::GetRandom().Get(objs), dst);
     }
 }
 
@@ -923,57 +885,45 @@ Battle::Cell *Battle::Board::GetCell(s32 position, int dir)
     return nullptr;
 }
 
+Battle::IndexSpan Battle::Board::GetMoveWideSpan(s32 center, bool reflect)
+{
+    return isValidIndex(center) ? IndexSpan(hexGeometry.moveWide[center][reflect], hexGeometry.moveWideCount[center][reflect])
+                                : IndexSpan(nullptr, 0);
+}
+
 Battle::Indexes Battle::Board::GetMoveWideIndexes(s32 center, bool reflect)
 {
-    Indexes result;
-    result.reserve(8);
+    const IndexSpan span = GetMoveWideSpan(center, reflect);
+    return Indexes(span.begin(), span.end());
+}
 
-    if (!isValidIndex(center))
-    {
-        return result;
-    }
-    if (reflect)
-    {
-        if (isValidDirection(center, LEFT)) result.push_back(GetIndexDirection(center, LEFT));
-        if (isValidDirection(center, RIGHT)) result.push_back(GetIndexDirection(center, RIGHT));
-        if (isValidDirection(center, TOP_LEFT)) result.push_back(GetIndexDirection(center, TOP_LEFT));
-        if (isValidDirection(center, BOTTOM_LEFT)) result.push_back(GetIndexDirection(center, BOTTOM_LEFT));
-    } else
-    {
-        if (isValidDirection(center, LEFT)) result.push_back(GetIndexDirection(center, LEFT));
-        if (isValidDirection(center, RIGHT)) result.push_back(GetIndexDirection(center, RIGHT));
-        if (isValidDirection(center, TOP_RIGHT)) result.push_back(GetIndexDirection(center, TOP_RIGHT));
-        if (isValidDirection(center, BOTTOM_RIGHT)) result.push_back(GetIndexDirection(center, BOTTOM_RIGHT));
-    }
-    return result;
+Battle::IndexSpan Battle::Board::GetAroundSpan(s32 center)
+{
+    return isValidIndex(center) ? IndexSpan(hexGeometry.aroundList[center], hexGeometry.aroundCount[center])
+                                : IndexSpan(nullptr, 0);
 }
 
 Battle::Indexes Battle::Board::GetAroundIndexes(s32 center)
 {
-    Indexes result;
-    result.reserve(12);
-
-    if (isValidIndex(center))
-    {
-        for (direction_t dir = TOP_LEFT; dir < CENTER; ++dir)
-            if (isValidDirection(center, dir)) result.push_back(GetIndexDirection(center, dir));
-    }
-
-    return result;
+    const IndexSpan span = GetAroundSpan(center);
+    return Indexes(span.begin(), span.end());
 }
 
 Battle::Indexes Battle::Board::GetAroundIndexes(const Unit &b)
 {
     if (b.isWide())
     {
-        Indexes around = GetAroundIndexes(b.GetHeadIndex());
-        const Indexes &tail = GetAroundIndexes(b.GetTailIndex());
-        around.insert(around.end(), tail.begin(), tail.end());
+        // the cells around both head and tail are listed twice
+        const s32 head = b.GetHeadIndex();
+        const s32 tail = b.GetTailIndex();
+        Indexes around;
+        around.reserve(12);
 
-        Indexes::iterator it_end = around.end();
-        it_end = remove(around.begin(), it_end, b.GetHeadIndex());
-        it_end = remove(around.begin(), it_end, b.GetTailIndex());
-        around.resize(distance(around.begin(), it_end));
+        for (const s32 index : GetAroundSpan(head))
+            if (index != tail) around.push_back(index);
+
+        for (const s32 index : GetAroundSpan(tail))
+            if (index != head) around.push_back(index);
 
         return around;
     }
@@ -981,45 +931,22 @@ Battle::Indexes Battle::Board::GetAroundIndexes(const Unit &b)
     return GetAroundIndexes(b.GetHeadIndex());
 }
 
-Battle::Indexes Battle::Board::GetDistanceIndexes(s32 center, uint32_t radius)
+Battle::IndexSpan Battle::Board::GetDistanceSpan(s32 center, uint32_t radius)
 {
-    Indexes result;
-
-    if (isValidIndex(center))
-    {
-        set<s32> st;
-        Indexes abroad;
-
-        st.insert(center);
-        abroad.push_back(center);
-
-        while (!abroad.empty() && radius)
-        {
-            set<s32> tm = st;
-
-            for (Indexes::const_iterator
-                         it = abroad.begin(); it != abroad.end(); ++it)
-            {
-                const Indexes around = GetAroundIndexes(*it);
-                tm.insert(around.begin(), around.end());
-            }
-
-            abroad.resize(tm.size());
-
-            Indexes::iterator abroad_end =
-                    set_difference(tm.begin(), tm.end(), st.begin(), st.end(), abroad.begin());
-
-            abroad.resize(distance(abroad.begin(), abroad_end));
+    if (!isValidIndex(center))
+        return IndexSpan(nullptr, 0);
 
-            st.swap(tm);
-            --radius;
-        }
+    // skip the center, first in the row
+    const uint32_t steps = min<uint32_t>(radius, HexGeometry::MAXSTEPS - 1);
+    return IndexSpan(hexGeometry.radius[center] + 1, hexGeometry.radiusEnd[center][steps] - 1);
+}
 
-        st.erase(center);
-        result.reserve(st.size());
-        copy(st.begin(), st.end(), back_inserter(result));
-    }
+Battle::Indexes Battle::Board::GetDistanceIndexes(s32 center, uint32_t radius)
+{
+    const IndexSpan span = GetDistanceSpan(center, radius);
+    Indexes result(span.begin(), span.end());
 
+    sort(result.begin(), result.end());
     return result;
 }
 
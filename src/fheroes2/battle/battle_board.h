@@ -26,10 +26,7 @@
 
 #include "battle.h"
 #include "battle_cell.h"
-
-#define ARENAW 11
-#define ARENAH 9
-#define ARENASIZE ARENAW * ARENAH
+#include "battle_geometry.h"
 
 namespace Battle
 {
@@ -60,6 +57,8 @@ namespace Battle
 
         Indexes GetAStarPath(const Unit &, const Position &, bool debug = true);
 
+        static uint32_t GetAStarQueries();
+
         string AllUnitsInfo() const;
 
         void SetEnemyQuality(const Unit &);
@@ -112,6 +111,13 @@ namespace Battle
 
         static Indexes GetMoveWideIndexes(s32, bool reflect);
 
+        // allocation free variants, the distance span is ordered by steps from the center
+        static IndexSpan GetDistanceSpan(s32, uint32_t);
+
+        static IndexSpan GetAroundSpan(s32);
+
+        static IndexSpan GetMoveWideSpan(s32, bool reflect);
+
         static bool isValidMirrorImageIndex(s32, const Unit *);
     };
 
@@ -66,7 +66,7 @@ uint32_t Battle::Catapult::GetDamage(int target, uint32_t value) const
         case CAT_WALL4:
             if (value)
             {
-                if (cat_first == 100 || cat_first >= Rand::Get(1, 100))
+                if (cat_first == 100 || cat_first >= Arena::GetRandom().Get(1, 100))
                 {
                     // value = value;
                 } else
@@ -158,7 +158,7 @@ int Battle::Catapult::GetTarget(const vector<uint32_t> &values) const
     if (!targets.empty())
     {
         // miss for 30%
-        return cat_miss && 7 > Rand::Get(1, 20) ? CAT_MISS : (1 < targets.size() ? *Rand::Get(targets)
+        return cat_miss && 7 > Arena::GetRandom().Get(1, 20) ? CAT_MISS : (1 < targets.size() ? *Arena::GetRandom().Get(targets)
                                                                                  : targets.front());
     }
 
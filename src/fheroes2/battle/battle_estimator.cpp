@@ -0,0 +1,209 @@
+/***************************************************************************
+ *   Copyright (C) 2012 by Andrey Afletdinov <fheroes2@gmail.com>          *
+ *                                                                         *
+ *   Part of the Free Heroes2 Engine:                                      *
+ *   http://sourceforge.net/projects/fheroes2                              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include <chrono>
+#include <map>
+#include <mutex>
+
+#include "army.h"
+#include "castle.h"
+#include "color.h"
+#include "heroes.h"
+#include "settings.h"
+#include "world.h"
+#include "battle_estimator.h"
+#include "battle_simulator.h"
+
+namespace
+{
+    // battles are cut after this many turns and count as lost
+    const uint32_t maxTurns = 50;
+
+    const size_t maxCache = 4096;
+
+    mutex cache_mutex;
+    map<vector<int>, Battle::Estimate> cache;
+
+    void KeyArmy(vector<int> &key, const Army &army)
+    {
+        const HeroBase *commander = army.GetCommander();
+
+        key.push_back(commander ? commander->GetAttack() : -1);
+        key.push_back(commander ? commander->GetDefense() : -1);
+        key.push_back(commander ? commander->GetPower() : -1);
+        key.push_back(commander ? commander->GetKnowledge() : -1);
+        key.push_back(commander ? commander->GetSpellPoints() : -1);
+        key.push_back(army.GetMorale());
+        key.push_back(army.GetLuck());
+        key.push_back(army.isSpreadFormat());
+
+        // what else of the commander changes a battle: skills, artifacts, known combat spells
+        if (commander)
+        {
+            for (int skill = Skill::Secondary::PATHFINDING; skill <= Skill::Secondary::ESTATES; ++skill)
+                key.push_back(commander->GetLevelSkill(skill));
+
+            for (const Artifact &art : commander->GetBagArtifacts())
+                if (art.isValid()) key.push_back(art.GetID());
+
+            key.push_back(-1);
+
+            for (int id = Spell::FIREBALL; id < Spell::RANDOM; ++id)
+                if (Spell(id).isCombat() && commander->HaveSpell(Spell(id))) key.push_back(id);
+
+            key.push_back(-1);
+        }
+
+        for (uint32_t ii = 0; ii < army.m_troops.Size(); ++ii)
+        {
+            const Troop *troop = army.m_troops.GetTroop(ii);
+            key.push_back(troop->isValid() ? troop->GetID() : 0);
+            key.push_back(troop->isValid() ? troop->GetCount() : 0);
+        }
+    }
+
+    vector<int> GetKey(const Army &attacker, const Army &defender, s32 index)
+    {
+        vector<int> key;
+        key.reserve(128);
+
+        if (Maps::isValidAbsIndex(index))
+        {
+            const Castle *castle = world.GetCastle(Maps::GetPoint(index));
+
+            key.push_back(world.GetTiles(index).GetGround());
+            key.push_back(castle ? index : -1);
+            key.push_back(castle && castle->isBuild(BUILD_LEFTTURRET));
+            key.push_back(castle && castle->isBuild(BUILD_RIGHTTURRET));
+            key.push_back(castle && castle->isBuild(BUILD_MOAT));
+            key.push_back(castle && castle->isBuild(BUILD_SPEC));
+        } else
+            key.push_back(-1);
+
+        KeyArmy(key, attacker);
+        KeyArmy(key, defender);
+
+        return key;
+    }
+
+    /* every simulated battle fights copies of the troops */
+    void CopyArmy(Army &copy, const Army &army)
+    {
+        // the arena wants the commander mutable, Restore undoes what a battle spends
+        copy.SetCommander(const_cast<HeroBase *>(army.GetCommander()));
+        copy.SetColor(army.GetColor());
+        copy.SetSpreadFormat(army.isSpreadFormat());
+
+        for (uint32_t ii = 0; ii < army.m_troops.Size() && ii < copy.m_troops.Size(); ++ii)
+            copy.m_troops.GetTroop(ii)->Set(*army.m_troops.GetTroop(ii));
+    }
+
+    /* spell points and the cast flag of a commander */
+    struct CommanderState
+    {
+        explicit CommanderState(const Army &army) :
+                commander(const_cast<HeroBase *>(army.GetCommander())),
+                points(commander ? commander->GetSpellPoints() : 0),
+                casted(commander && commander->Modes(Heroes::SPELLCASTED))
+        {}
+
+        void Restore() const
+        {
+            if (!commander) return;
+
+            commander->SetSpellPoints(points);
+            if (casted)
+                commander->SetModes(Heroes::SPELLCASTED);
+            else
+                commander->ResetModes(Heroes::SPELLCASTED);
+        }
+
+        HeroBase *commander;
+        uint32_t points;
+        bool casted;
+    };
+}
+
+Battle::Estimator::Estimator(uint32_t count) : battles(count), budget(Settings::Get().AIEstimateBudget())
+{
+}
+
+Battle::Estimate Battle::Estimator::Get(const Army &attacker, const Army &defender, s32 index) const
+{
+    const vector<int> key = GetKey(attacker, defender, index);
+
+    {
+        lock_guard<mutex> lock(cache_mutex);
+        auto it = cache.find(key);
+        if (it != cache.end()) return it->second;
+    }
+
+    // the seeds come from the key: the same battle gives the same estimate
+    uint32_t seed = 2166136261u;
+    for (int value : key)
+        seed = (seed ^ static_cast<uint32_t>(value)) * 16777619u;
+
+    const CommanderState state1(attacker);
+    const CommanderState state2(defender);
+    const double strength = max(1u, attacker.m_troops.GetStrength());
+    const Simulator simulator(maxTurns);
+    const auto stop = chrono::steady_clock::now() + chrono::milliseconds(budget);
+
+    Estimate estimate;
+    uint32_t wins = 0;
+    double losses = 0;
+
+    // the full count unless a budget is set, then at least one battle and as many as it allows
+    while (estimate.battles < battles &&
+           (0 == budget || 0 == estimate.battles || chrono::steady_clock::now() < stop))
+    {
+        Army army1;
+        Army army2;
+        CopyArmy(army1, attacker);
+        CopyArmy(army2, defender);
+
+        SimulatorJob job(army1, army2, index, seed + estimate.battles);
+        simulator.Run(job);
+
+        state1.Restore();
+        state2.Restore();
+
+        if (job.result.army1 & RESULT_WINS) ++wins;
+        losses += 1.0 - army1.m_troops.GetStrength() / strength;
+        ++estimate.battles;
+    }
+
+    estimate.win = static_cast<double>(wins) / estimate.battles;
+    estimate.losses = losses / estimate.battles;
+
+    lock_guard<mutex> lock(cache_mutex);
+    if (cache.size() >= maxCache) cache.clear();
+    cache[key] = estimate;
+
+    return estimate;
+}
+
+void Battle::Estimator::ClearCache()
+{
+    lock_guard<mutex> lock(cache_mutex);
+    cache.clear();
+}
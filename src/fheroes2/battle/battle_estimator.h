@@ -0,0 +1,59 @@
+/***************************************************************************
+ *   Copyright (C) 2012 by Andrey Afletdinov <fheroes2@gmail.com>          *
+ *                                                                         *
+ *   Part of the Free Heroes2 Engine:                                      *
+ *   http://sourceforge.net/projects/fheroes2                              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#pragma once
+
+#include "battle.h"
+
+class Army;
+
+namespace Battle
+{
+    struct Estimate
+    {
+        Estimate() : win(0), losses(0), battles(0)
+        {}
+
+        double win;       // share of battles won by the attacker
+        double losses;    // expected share of the attacker strength lost
+        uint32_t battles;
+    };
+
+    /* outcome of a prospective battle from headless simulations, memoised by
+       troops, commander stats and battlefield; the commanders are restored after each battle.
+       A cache miss costs at most the battle count times a 50 turn simulation, the battle
+       bench -e prints that cost; the optional budget only cuts it shorter */
+    class Estimator
+    {
+    public:
+        // the "ai estimate budget" setting may cut the battles short
+        explicit Estimator(uint32_t battles = 12);
+
+        Estimate Get(const Army &attacker, const Army &defender, s32 index) const;
+
+        static void ClearCache();
+
+    private:
+        uint32_t battles;
+        uint32_t budget; // ms, 0 - always the full count
+    };
+}
@@ -0,0 +1,82 @@
+/***************************************************************************
+ *   Copyright (C) 2012 by Andrey Afletdinov <fheroes2@gmail.com>          *
+ *                                                                         *
+ *   Part of the Free Heroes2 Engine:                                      *
+ *   http://sourceforge.net/projects/fheroes2                              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include "battle_geometry.h"
+
+namespace Battle
+{
+    static_assert(1 == HexMath::Distance(0, 1) && 1 == HexMath::Distance(0, 11) &&
+                  10 == HexMath::Distance(0, 10) && 10 == HexMath::Distance(0, 98) &&
+                  !HexMath::IsValidSlot(0, 0) && 0 == HexMath::SlotIndex(11, 1) &&
+                  12 == HexMath::SlotIndex(11, 2) && 22 == HexMath::SlotIndex(11, 3) &&
+                  !HexMath::IsValidSlot(11, 4) && RIGHT == HexMath::SlotDirection(2) &&
+                  2 == HexMath::Steps(0, 22) && 14 == HexMath::Steps(0, 98),
+                  "hex geometry differs from the arena layout");
+
+    const HexGeometry hexGeometry;
+}
+
+Battle::HexGeometry::HexGeometry() : around{}, aroundList{}, aroundCount{}, moveWide{}, moveWideCount{}, mask{},
+        distance{}, direction{}, radius{}, radiusEnd{}
+{
+    // GetMoveWideIndexes order, reflect at 1
+    const int wideSlots[2][4] = {{5, 2, 1, 3}, {5, 2, 0, 4}};
+
+    for (s32 index = 0; index < ARENASIZE; ++index)
+    {
+        for (int slot = 0; slot < 6; ++slot)
+        {
+            const bool valid = HexMath::IsValidSlot(index, slot);
+
+            around[index][slot] = valid ? HexMath::SlotIndex(index, slot) : -1;
+
+            if (valid)
+            {
+                aroundList[index][aroundCount[index]++] = around[index][slot];
+                mask[index] |= HexMath::SlotDirection(slot);
+                direction[index][around[index][slot]] = HexMath::SlotDirection(slot);
+            }
+        }
+
+        for (int reflect = 0; reflect < 2; ++reflect)
+            for (int slot : wideSlots[reflect])
+                if (0 <= around[index][slot])
+                    moveWide[index][reflect][moveWideCount[index][reflect]++] = around[index][slot];
+
+        direction[index][index] = CENTER;
+
+        for (s32 index2 = 0; index2 < ARENASIZE; ++index2)
+            distance[index][index2] = HexMath::Distance(index, index2);
+
+        // cells ordered by steps, then by index
+        int count = 0;
+
+        for (int steps = 0; steps < MAXSTEPS; ++steps)
+        {
+            for (s32 index2 = 0; index2 < ARENASIZE; ++index2)
+                if (steps == HexMath::Steps(index, index2))
+                    radius[index][count++] = index2;
+
+            radiusEnd[index][steps] = count;
+        }
+    }
+}
@@ -0,0 +1,147 @@
+/***************************************************************************
+ *   Copyright (C) 2012 by Andrey Afletdinov <fheroes2@gmail.com>          *
+ *                                                                         *
+ *   Part of the Free Heroes2 Engine:                                      *
+ *   http://sourceforge.net/projects/fheroes2                              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#pragma once
+
+#include "types.h"
+#include "battle_cell.h"
+
+#define ARENAW 11
+#define ARENAH 9
+#define ARENASIZE ARENAW * ARENAH
+
+namespace Battle
+{
+    /* hex geometry of the arena, arithmetic used to fill the tables */
+    namespace HexMath
+    {
+        /* TOP_LEFT .. LEFT as 0 .. 5, clockwise */
+        constexpr int DirectionSlot(int dir)
+        {
+            return TOP_LEFT == dir ? 0 : TOP_RIGHT == dir ? 1 : RIGHT == dir ? 2 :
+                   BOTTOM_RIGHT == dir ? 3 : BOTTOM_LEFT == dir ? 4 : LEFT == dir ? 5 : -1;
+        }
+
+        constexpr int SlotDirection(int slot)
+        {
+            return 1 << slot;
+        }
+
+        constexpr bool IsValidSlot(s32 index, int slot)
+        {
+            return 0 == slot ? !(0 == index / ARENAW || (0 == index % ARENAW && (index / ARENAW) % 2)) :
+                   1 == slot ? !(0 == index / ARENAW || (ARENAW - 1 == index % ARENAW && !((index / ARENAW) % 2))) :
+                   2 == slot ? ARENAW - 1 != index % ARENAW :
+                   3 == slot ? !(ARENAH - 1 == index / ARENAW || (ARENAW - 1 == index % ARENAW && !((index / ARENAW) % 2))) :
+                   4 == slot ? !(ARENAH - 1 == index / ARENAW || (0 == index % ARENAW && (index / ARENAW) % 2)) :
+                   5 == slot && 0 != index % ARENAW;
+        }
+
+        constexpr s32 SlotIndex(s32 index, int slot)
+        {
+            return 0 == slot ? index - ((index / ARENAW) % 2 ? ARENAW + 1 : ARENAW) :
+                   1 == slot ? index - ((index / ARENAW) % 2 ? ARENAW : ARENAW - 1) :
+                   2 == slot ? index + 1 :
+                   3 == slot ? index + ((index / ARENAW) % 2 ? ARENAW : ARENAW + 1) :
+                   4 == slot ? index + ((index / ARENAW) % 2 ? ARENAW - 1 : ARENAW) :
+                   index - 1;
+        }
+
+        constexpr s32 Abs(s32 value)
+        {
+            return 0 > value ? -value : value;
+        }
+
+        /* the Board::GetDistance estimate */
+        constexpr s32 Distance(s32 index1, s32 index2)
+        {
+            return (0 < index1 % ARENAW - index2 % ARENAW) == (0 < index1 / ARENAW - index2 / ARENAW) &&
+                   (0 > index1 % ARENAW - index2 % ARENAW) == (0 > index1 / ARENAW - index2 / ARENAW)
+                   ? (Abs(index1 % ARENAW - index2 % ARENAW) > Abs(index1 / ARENAW - index2 / ARENAW)
+                      ? Abs(index1 % ARENAW - index2 % ARENAW) : Abs(index1 / ARENAW - index2 / ARENAW))
+                   : Abs(index1 % ARENAW - index2 % ARENAW) + Abs(index1 / ARENAW - index2 / ARENAW);
+        }
+
+        /* the exact number of moves, odd rows are shifted left */
+        constexpr s32 CubeQ(s32 index)
+        {
+            return index % ARENAW - (index / ARENAW + (index / ARENAW) % 2) / 2;
+        }
+
+        constexpr s32 Steps(s32 index1, s32 index2)
+        {
+            return (Abs(CubeQ(index1) - CubeQ(index2)) + Abs(index1 / ARENAW - index2 / ARENAW) +
+                    Abs(CubeQ(index1) - CubeQ(index2) + index1 / ARENAW - index2 / ARENAW)) / 2;
+        }
+    }
+
+    /* read-only view of a geometry table row, iterated without copying into Indexes */
+    class IndexSpan
+    {
+    public:
+        IndexSpan(const s8 *first, size_t count) : first(first), count(count)
+        {}
+
+        const s8 *begin() const
+        { return first; }
+
+        const s8 *end() const
+        { return first + count; }
+
+        size_t size() const
+        { return count; }
+
+        bool empty() const
+        { return 0 == count; }
+
+        s32 operator[](size_t ii) const
+        { return first[ii]; }
+
+    private:
+        const s8 *first;
+        size_t count;
+    };
+
+    struct HexGeometry
+    {
+        enum
+        {
+            MAXSTEPS = ARENAW + ARENAH
+        };
+
+        HexGeometry();
+
+        s8 around[ARENASIZE][6];              // neighbour per direction slot, -1 out of the board
+        s8 aroundList[ARENASIZE][6];          // GetAroundIndexes
+        u8 aroundCount[ARENASIZE];
+        s8 moveWide[ARENASIZE][2][4];         // GetMoveWideIndexes, reflect at 1
+        u8 moveWideCount[ARENASIZE][2];
+        u8 mask[ARENASIZE];                   // valid directions
+        u8 distance[ARENASIZE][ARENASIZE];    // GetDistance
+        u8 direction[ARENASIZE][ARENASIZE];   // GetDirection
+        s8 radius[ARENASIZE][ARENASIZE];      // all cells by steps from the center, the center first
+        u8 radiusEnd[ARENASIZE][MAXSTEPS];    // end of the cells within that many steps in radius
+    };
+
+    // filled at startup, too many steps for a compile time constant
+    extern const HexGeometry hexGeometry;
+}
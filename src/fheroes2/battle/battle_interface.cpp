@@ -161,10 +161,21 @@ namespace Battle
         bool openlog;
     };
 
+    bool turbo = false;
+
     bool AnimateInfrequentDelay(int dl)
     {
-        //return true;
-        return Game::AnimateInfrequentDelay(dl);
+        return turbo || Game::AnimateInfrequentDelay(dl);
+    }
+
+    void AnimatePause(uint32_t ms)
+    {
+        if (!turbo) DELAY(ms);
+    }
+
+    void WaitSoundEnd()
+    {
+        while (!turbo && Mixer::isValid() && Mixer::isPlaying(-1)) DELAY(10);
     }
 }
 
@@ -2161,9 +2172,7 @@ int Battle::Interface::GetAllowSwordDirection(uint32_t index) const
     {
         return res;
     }
-    const Indexes around = Board::GetAroundIndexes(index);
-
-    for (int from : around)
+    for (const s32 from : Board::GetAroundSpan(index))
     {
         if (UNKNOWN != Board::GetCell(from)->GetDirection() ||
             from == b_current->GetHeadIndex() ||
@@ -2413,7 +2422,7 @@ void Battle::Interface::RedrawActionAttackPart1(Unit &attacker, Unit &defender,
         attacker.ResetAnimFrame(action1);
         RedrawTroopFrameAnimation(attacker);
     }
-    DELAY(200);
+    AnimatePause(200);
 
     // draw missile animation
     if (archer)
@@ -2618,7 +2627,7 @@ void Battle::Interface::RedrawActionWincesKills(TargetsInfo &targets)
         py += 10;
     }
 
-    DELAY(200);
+    AnimatePause(200);
 }
 
 void Battle::Interface::RedrawActionMove(Unit &b, const Indexes &path)
@@ -3091,7 +3100,7 @@ void Battle::Interface::RedrawActionLuck(Unit &b)
         }
     }
 
-    DELAY(400);
+    AnimatePause(400);
 }
 
 void Battle::Interface::RedrawActionMorale(Unit &b, bool good)
@@ -3355,7 +3364,7 @@ void Battle::Interface::RedrawActionTeleportSpell(Unit &target, s32 dst)
     b_current_alpha = 0;
     cursor.Hide();
     Redraw();
-    while (Mixer::isValid() && Mixer::isPlaying(-1)) DELAY(10);
+    WaitSoundEnd();
 
     target.SetPosition(dst);
     AGG::PlaySound(M82::TELPTIN);
@@ -3493,8 +3502,8 @@ namespace
         for (int i = 1; i<steps; i++)
         {
             Point interpolated = pointLerp(start, endPoint, pos);
-            interpolated.x += Rand::Get(-20, 20);
-            interpolated.y += Rand::Get(-20, 20);
+            interpolated.x += Rand::Cosmetic().Get(-20, 20);
+            interpolated.y += Rand::Cosmetic().Get(-20, 20);
             drawPoints.push_back(interpolated);
             pos += floatPart;
         }
@@ -3569,9 +3578,9 @@ void Battle::Interface::RedrawActionBloodLustSpell(Unit &target)
         alpha += 10;
     }
 
-    DELAY(100);
+    AnimatePause(100);
 
-    while (Mixer::isValid() && Mixer::isPlaying(-1)) DELAY(10);
+    WaitSoundEnd();
 
     b_current = nullptr;
     b_current_sprite = nullptr;
@@ -3931,7 +3940,7 @@ void Battle::Interface::RedrawActionArmageddonSpell(const TargetsInfo &targets)
                 restore = false;
             } else
             {
-                switch (Rand::Get(1, 4))
+                switch (Rand::Cosmetic().Get(1, 4))
                 {
                     case 1:
                         sprite1.Blit(area.x + offset, area.y + offset, display);
@@ -3960,7 +3969,7 @@ void Battle::Interface::RedrawActionArmageddonSpell(const TargetsInfo &targets)
         }
     }
 
-    while (Mixer::isValid() && Mixer::isPlaying(-1)) DELAY(10);
+    WaitSoundEnd();
 }
 
 void Battle::Interface::RedrawActionEarthQuakeSpell(const vector<int> &targets)
@@ -3998,7 +4007,7 @@ void Battle::Interface::RedrawActionEarthQuakeSpell(const vector<int> &targets)
                 restore = false;
             } else
             {
-                switch (Rand::Get(1, 4))
+                switch (Rand::Cosmetic().Get(1, 4))
                 {
                     case 1:
                         sprite.Blit(area.x + offset, area.y + offset, display);
@@ -4311,6 +4320,16 @@ void Battle::Interface::RedrawBridgeAnimation(bool down)
     if (!down) AGG::PlaySound(M82::DRAWBRG);
 }
 
+void Battle::Interface::SetTurboMode(bool f)
+{
+    turbo = f;
+}
+
+bool Battle::Interface::isTurboMode()
+{
+    return turbo;
+}
+
 bool Battle::Interface::IdleTroopsAnimation() const
 {
     // set animation
@@ -4336,12 +4355,12 @@ void Battle::Interface::CheckGlobalEvents(LocalEvent &le)
     {
         if (opponent1)
         {
-            if (!opponent1->isStartFrame() || 2 > Rand::Get(1, 10)) opponent1->IncreaseAnimFrame();
+            if (!opponent1->isStartFrame() || 2 > Rand::Cosmetic().Get(1, 10)) opponent1->IncreaseAnimFrame();
         }
 
         if (opponent2)
         {
-            if (!opponent2->isStartFrame() || 2 > Rand::Get(1, 10)) opponent2->IncreaseAnimFrame();
+            if (!opponent2->isStartFrame() || 2 > Rand::Cosmetic().Get(1, 10)) opponent2->IncreaseAnimFrame();
         }
         humanturn_redraw = true;
     }
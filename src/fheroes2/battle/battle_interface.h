@@ -219,6 +219,11 @@ namespace Battle
 
         void RedrawBridgeAnimation(bool down);
 
+        /* replays: animations without frame delays and sound pauses */
+        static void SetTurboMode(bool);
+
+        static bool isTurboMode();
+
     private:
         void HumanBattleTurn(const Unit &, Actions &, string &);
 
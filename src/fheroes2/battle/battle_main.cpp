@@ -21,6 +21,8 @@
  ***************************************************************************/
 
 #include <algorithm>
+#include <ctime>
+#include <iostream>
 #include "army.h"
 #include "artifact.h"
 #include "settings.h"
@@ -30,10 +32,14 @@
 #include "dialog.h"
 #include "world.h"
 #include "game.h"
+#include "game_autoplay.h"
 #include "ai.h"
+#include "ai_profiler.h"
 #include "battle_arena.h"
 #include "battle_army.h"
+#include "battle_replay.h"
 #include "rand.h"
+#include "system.h"
 #include "icn.h"
 
 namespace Battle
@@ -47,6 +53,11 @@ namespace Battle
 
 Battle::Result Battle::Loader(Army &army1, Army &army2, s32 mapsindex)
 {
+    Game::Autoplay::Timer timer(Game::Autoplay::BATTLE);
+    AI::Profiler::Scope scope(AI::Profiler::BATTLE);
+
+    AI::Profiler::Count(AI::Profiler::BATTLES);
+
     // pre battle army1
     if (army1.GetCommander())
     {
@@ -73,7 +84,18 @@ Battle::Result Battle::Loader(Army &army1, Army &army2, s32 mapsindex)
     bool local = army1.isControlHuman() || army2.isControlHuman();
 
 
-    Arena arena(army1, army2, mapsindex, local);
+    const uint32_t seed = Rand::GetSeed();
+    Arena arena(army1, army2, mapsindex, local, seed);
+
+    // optional record for the post-mortem playback
+    up<Replay> replay;
+
+    if (Settings::Get().ExtBattleRecordReplays())
+    {
+        replay = make_unique<Replay>();
+        replay->Start(army1, army2, mapsindex, seed);
+        arena.SetReplay(replay.get());
+    }
 
     while (arena.BattleValid())
         arena.Turns();
@@ -81,6 +103,15 @@ Battle::Result Battle::Loader(Army &army1, Army &army2, s32 mapsindex)
     const Result &result = arena.GetResult();
     AGG::ResetMixer();
 
+    if (replay)
+    {
+        ostringstream os;
+        os << System::ConcatePath(Settings::GetSaveDir(), "battle_") << time(nullptr) << "_" << seed << ".rpl";
+
+        replay->Finish(result, arena.GetCurrentTurn());
+        if (!replay->Save(os.str())) ERROR("cannot write battle replay: " << os.str());
+    }
+
     HeroBase *hero_wins = (result.army1 & RESULT_WINS ? army1.GetCommander() : (result.army2 & RESULT_WINS
                                                                                 ? army2.GetCommander() : nullptr));
     HeroBase *hero_loss = (result.army1 & RESULT_LOSS ? army1.GetCommander() : (result.army2 & RESULT_LOSS
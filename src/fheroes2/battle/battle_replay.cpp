@@ -0,0 +1,414 @@
+/***************************************************************************
+ *   Copyright (C) 2012 by Andrey Afletdinov <fheroes2@gmail.com>          *
+ *                                                                         *
+ *   Part of the Free Heroes2 Engine:                                      *
+ *   http://sourceforge.net/projects/fheroes2                              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include <iostream>
+
+#include "BinaryFileReader.h"
+#include "ByteVectorReader.h"
+#include "ByteVectorWriter.h"
+#include "army.h"
+#include "castle.h"
+#include "heroes.h"
+#include "world.h"
+#include "battle_command.h"
+#include "battle_interface.h"
+#include "battle_replay.h"
+
+namespace
+{
+    const u16 REPLAY_ID = 0xFB02;
+
+    void HashValue(uint32_t &hash, int value)
+    {
+        hash = (hash ^ static_cast<uint32_t>(value)) * 16777619u;
+    }
+
+    /* what of a commander besides the spell points changes the battle */
+    uint32_t CommanderState(const HeroBase *commander)
+    {
+        uint32_t hash = 2166136261u;
+
+        if (!commander) return hash;
+
+        HashValue(hash, commander->GetAttack());
+        HashValue(hash, commander->GetDefense());
+        HashValue(hash, commander->GetPower());
+        HashValue(hash, commander->GetKnowledge());
+
+        for (int skill = Skill::Secondary::PATHFINDING; skill <= Skill::Secondary::ESTATES; ++skill)
+            HashValue(hash, commander->GetLevelSkill(skill));
+
+        for (const Artifact &art : commander->GetBagArtifacts())
+            HashValue(hash, art.GetID());
+
+        for (int id = Spell::FIREBALL; id < Spell::RANDOM; ++id)
+            if (commander->HaveSpell(Spell(id))) HashValue(hash, id);
+
+        return hash;
+    }
+
+    /* a count read from the file fits in the remaining bytes */
+    bool ValidCount(const ByteVectorReader &msg, uint32_t count, uint32_t bytes)
+    {
+        return msg.tell() <= msg.size() &&
+               static_cast<uint64_t>(count) * bytes <= msg.size() - msg.tell();
+    }
+
+    void WriteArmy(ByteVectorWriter &msg, const Battle::ReplayArmy &army)
+    {
+        msg << army.color << army.hero << army.captain << army.spread << army.spell_points << army.commander_state <<
+            static_cast<uint32_t>(army.troops.size());
+
+        for (const auto &troop : army.troops)
+            msg << troop.first << troop.second;
+    }
+
+    bool ReadArmy(ByteVectorReader &msg, Battle::ReplayArmy &army)
+    {
+        uint32_t size = 0;
+
+        msg >> army.color >> army.hero >> army.captain >> army.spread >> army.spell_points >> army.commander_state >>
+            size;
+
+        if (size > ARMYMAXTROOPS || !ValidCount(msg, size, 8))
+            return false;
+
+        army.troops.resize(size);
+
+        for (auto &troop : army.troops)
+            msg >> troop.first >> troop.second;
+
+        return true;
+    }
+}
+
+Battle::Replay::Replay() : mapsindex(-1), seed(0), turns(0), position(0), playback(false), exhausted(false)
+{
+}
+
+void Battle::Replay::Start(const Army &army1, const Army &army2, s32 index, uint32_t rnd)
+{
+    const Army *sides[] = {&army1, &army2};
+
+    for (int side = 0; side < 2; ++side)
+    {
+        const Army &army = *sides[side];
+        const HeroBase *commander = army.GetCommander();
+        ReplayArmy &replay = armies[side];
+
+        replay = ReplayArmy();
+        replay.color = army.GetColor();
+        replay.spread = army.isSpreadFormat();
+
+        if (commander)
+        {
+            if (commander->isHeroes())
+                replay.hero = static_cast<const Heroes *>(commander)->GetID();
+            else if (commander->isCaptain() && commander->inCastle())
+                replay.captain = commander->inCastle()->GetIndex();
+
+            replay.spell_points = commander->GetSpellPoints();
+        }
+
+        replay.commander_state = CommanderState(commander);
+
+        for (uint32_t ii = 0; ii < army.m_troops.Size(); ++ii)
+        {
+            const Troop *troop = army.m_troops.GetTroop(ii);
+            replay.troops.emplace_back(troop->GetID(), troop->GetCount());
+        }
+    }
+
+    mapsindex = index;
+    seed = rnd;
+    decisions.clear();
+    result = Result();
+    turns = 0;
+    position = 0;
+    playback = false;
+    exhausted = false;
+}
+
+void Battle::Replay::Record(const Actions &actions)
+{
+    decisions.push_back(actions);
+}
+
+void Battle::Replay::Finish(const Result &res, uint32_t count)
+{
+    result = res;
+    turns = count;
+}
+
+bool Battle::Replay::Save(const string &file) const
+{
+    ByteVectorWriter msg(16 * 1024);
+    msg.SetBigEndian(true);
+
+    msg << REPLAY_ID << mapsindex << seed;
+    WriteArmy(msg, armies[0]);
+    WriteArmy(msg, armies[1]);
+    msg << static_cast<uint32_t>(decisions.size());
+
+    for (const auto &actions : decisions)
+    {
+        msg << static_cast<uint32_t>(actions.size());
+
+        for (const auto &cmd : actions)
+        {
+            msg << cmd.GetType() << static_cast<uint32_t>(cmd.size());
+
+            for (int value : cmd)
+                msg << value;
+        }
+    }
+
+    msg << result << turns << REPLAY_ID;
+
+    FileUtils::writeFileBytes(file, msg.data());
+    return FileUtils::Exists(file);
+}
+
+bool Battle::Replay::Load(const string &file)
+{
+    const vector<u8> data = FileUtils::readFileBytes(file);
+    ByteVectorReader msg(data);
+    msg.setBigEndian(true);
+
+    u16 id = 0;
+    uint32_t size = 0;
+
+    if (!ValidCount(msg, 1, 2))
+        return false;
+
+    msg >> id;
+
+    if (id != REPLAY_ID || !ValidCount(msg, 1, 8))
+        return false;
+
+    msg >> mapsindex >> seed;
+
+    if (!ReadArmy(msg, armies[0]) || !ReadArmy(msg, armies[1]) || !ValidCount(msg, 1, 4))
+        return false;
+
+    msg >> size;
+
+    if (!ValidCount(msg, size, 4))
+        return false;
+
+    decisions.clear();
+    decisions.resize(size);
+
+    for (auto &actions : decisions)
+    {
+        uint32_t count = 0;
+        msg >> count;
+
+        if (!ValidCount(msg, count, 8))
+            return false;
+
+        for (uint32_t ii = 0; ii < count; ++ii)
+        {
+            int type = MSG_UNKNOWN;
+            uint32_t values = 0;
+            msg >> type >> values;
+
+            if (!ValidCount(msg, values, 4))
+                return false;
+
+            actions.push_back(Command(type));
+            Command &cmd = actions.back();
+            cmd.resize(values);
+
+            for (int &value : cmd)
+                msg >> value;
+        }
+    }
+
+    if (!ValidCount(msg, 1, 20 + 4 + 2))
+        return false;
+
+    msg >> result >> turns >> id;
+
+    position = 0;
+    playback = true;
+    exhausted = false;
+
+    return id == REPLAY_ID;
+}
+
+bool Battle::Replay::isPlayback() const
+{
+    return playback;
+}
+
+bool Battle::Replay::NextActions(Actions &actions)
+{
+    if (position < decisions.size())
+    {
+        actions.insert(actions.end(), decisions[position].begin(), decisions[position].end());
+        ++position;
+        return true;
+    }
+
+    exhausted = true;
+    return false;
+}
+
+bool Battle::Replay::isExhausted() const
+{
+    return exhausted;
+}
+
+HeroBase *Battle::Replay::GetCommander(int side) const
+{
+    const ReplayArmy &replay = armies[side];
+
+    if (0 <= replay.hero)
+        return world.GetHeroes(replay.hero);
+
+    if (Maps::isValidAbsIndex(replay.captain))
+    {
+        Castle *castle = world.GetCastle(Maps::GetPoint(replay.captain));
+        if (castle) return &castle->GetCaptain();
+    }
+
+    return nullptr;
+}
+
+bool Battle::Replay::ValidCommanders() const
+{
+    for (int side = 0; side < 2; ++side)
+    {
+        const ReplayArmy &replay = armies[side];
+        const HeroBase *commander = GetCommander(side);
+
+        if ((0 <= replay.hero || Maps::isValidAbsIndex(replay.captain)) && !commander)
+            return false;
+
+        if (replay.commander_state != CommanderState(commander))
+            return false;
+    }
+
+    return true;
+}
+
+void Battle::Replay::RestoreArmy(Army &army, int side) const
+{
+    const ReplayArmy &replay = armies[side];
+
+    army.SetCommander(GetCommander(side));
+    army.SetColor(replay.color);
+    army.SetSpreadFormat(replay.spread);
+
+    for (uint32_t ii = 0; ii < replay.troops.size() && ii < army.m_troops.Size(); ++ii)
+        army.m_troops.GetTroop(ii)->Set(Monster(replay.troops[ii].first), replay.troops[ii].second);
+
+    if (army.GetCommander())
+        army.GetCommander()->SetSpellPoints(replay.spell_points);
+}
+
+s32 Battle::Replay::GetIndex() const
+{
+    return mapsindex;
+}
+
+uint32_t Battle::Replay::GetSeed() const
+{
+    return seed;
+}
+
+const Battle::Result &Battle::Replay::GetResult() const
+{
+    return result;
+}
+
+uint32_t Battle::Replay::GetTurns() const
+{
+    return turns;
+}
+
+bool Battle::PlayReplay(const string &file, bool render, bool turbo)
+{
+    Replay replay;
+
+    if (!replay.Load(file))
+    {
+        ERROR("cannot read battle replay: " << file);
+        return false;
+    }
+
+    // the commands were chosen for the commanders as they were, other skills or artifacts desync them
+    if (!replay.ValidCommanders())
+    {
+        ERROR("battle replay commanders differ from the loaded game: " << file);
+        return false;
+    }
+
+    Army army1;
+    Army army2;
+    HeroBase *commander1 = replay.GetCommander(0);
+    HeroBase *commander2 = replay.GetCommander(1);
+
+    // the battle spends the spell points of the commanders from the loaded game
+    const uint32_t points1 = commander1 ? commander1->GetSpellPoints() : 0;
+    const uint32_t points2 = commander2 ? commander2->GetSpellPoints() : 0;
+
+    replay.RestoreArmy(army1, 0);
+    replay.RestoreArmy(army2, 1);
+
+    Interface::SetTurboMode(render && turbo);
+
+    Result result;
+    uint32_t turns = 0;
+    {
+        Arena arena(army1, army2, replay.GetIndex(), render, replay.GetSeed());
+        arena.SetReplay(&replay);
+
+        while (arena.BattleValid())
+            arena.Turns();
+
+        result = arena.GetResult();
+        turns = arena.GetCurrentTurn();
+
+        if (render) arena.FadeArena();
+    }
+
+    Interface::SetTurboMode(false);
+
+    if (commander1) commander1->SetSpellPoints(points1);
+    if (commander2) commander2->SetSpellPoints(points2);
+
+    const Result &recorded = replay.GetResult();
+    const bool same = turns == replay.GetTurns() &&
+                      result.army1 == recorded.army1 && result.army2 == recorded.army2 &&
+                      result.killed == recorded.killed;
+
+    if (!same)
+    {
+        ERROR("battle replay differs from the record: " << file << ", turns: " << turns <<
+              " (" << replay.GetTurns() << "), result: " << result.army1 << "/" << result.army2 <<
+              " (" << recorded.army1 << "/" << recorded.army2 << ")");
+    }
+
+    return same;
+}
@@ -0,0 +1,105 @@
+/***************************************************************************
+ *   Copyright (C) 2012 by Andrey Afletdinov <fheroes2@gmail.com>          *
+ *                                                                         *
+ *   Part of the Free Heroes2 Engine:                                      *
+ *   http://sourceforge.net/projects/fheroes2                              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#pragma once
+
+#include <vector>
+
+#include "battle.h"
+#include "battle_arena.h"
+#include "battle_command.h"
+
+class Army;
+
+class HeroBase;
+
+namespace Battle
+{
+    /* one side of a recorded battle; commanders are taken from the loaded game and must match its state */
+    struct ReplayArmy
+    {
+        ReplayArmy() : color(0), hero(-1), captain(-1), spread(true), spell_points(0), commander_state(0)
+        {}
+
+        int color;
+        int hero;        // heroes id or -1
+        s32 captain;     // castle index of a captain or -1
+        bool spread;
+        uint32_t spell_points;
+        uint32_t commander_state; // checksum of the skills, artifacts and spells of the commander
+        vector<pair<int, uint32_t>> troops; // monster, count for every army slot
+    };
+
+    /* initial armies, seed and decisions of one battle; everything else the arena derives again */
+    class Replay
+    {
+    public:
+        Replay();
+
+        // record
+        void Start(const Army &, const Army &, s32 index, uint32_t seed);
+
+        void Record(const Actions &);
+
+        void Finish(const Result &, uint32_t turns);
+
+        bool Save(const string &) const;
+
+        // playback
+        bool Load(const string &);
+
+        bool isPlayback() const;
+
+        bool NextActions(Actions &);
+
+        bool isExhausted() const;
+
+        HeroBase *GetCommander(int side) const;
+
+        /* the commanders of the loaded game are in the recorded state */
+        bool ValidCommanders() const;
+
+        void RestoreArmy(Army &, int side) const;
+
+        s32 GetIndex() const;
+
+        uint32_t GetSeed() const;
+
+        const Result &GetResult() const;
+
+        uint32_t GetTurns() const;
+
+    private:
+        ReplayArmy armies[2];
+        s32 mapsindex;
+        uint32_t seed;
+        vector<Actions> decisions;
+        Result result;
+        uint32_t turns;
+        size_t position;
+        bool playback;
+        bool exhausted;
+    };
+
+    /* fights the recorded battle again, false if the result differs from the record */
+    bool PlayReplay(const string &, bool render, bool turbo);
+}
@@ -0,0 +1,83 @@
+/***************************************************************************
+ *   Copyright (C) 2012 by Andrey Afletdinov <fheroes2@gmail.com>          *
+ *                                                                         *
+ *   Part of the Free Heroes2 Engine:                                      *
+ *   http://sourceforge.net/projects/fheroes2                              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+#include "army.h"
+#include "color.h"
+#include "battle_arena.h"
+#include "battle_army.h"
+#include "battle_simulator.h"
+
+Battle::Simulator::Simulator(uint32_t turns) : maxturns(turns)
+{
+}
+
+void Battle::Simulator::Run(SimulatorJob &job) const
+{
+    Arena arena(*job.army1, *job.army2, job.mapsindex, false, job.seed);
+
+    // human colors too
+    arena.SetAutoBattle(Color::ALL);
+
+    while (arena.BattleValid() && arena.GetCurrentTurn() < maxturns)
+        arena.Turns();
+
+    job.result = arena.GetResult();
+    job.turns = arena.GetCurrentTurn();
+
+    // save count troop
+    arena.GetForce1().SyncArmyCount();
+    arena.GetForce2().SyncArmyCount();
+}
+
+void Battle::Simulator::RunBatch(vector<SimulatorJob> &jobs, uint32_t threads) const
+{
+    if (0 == threads)
+        threads = max(1u, thread::hardware_concurrency());
+
+    threads = min<uint32_t>(threads, jobs.size());
+
+    if (1 >= threads)
+    {
+        for (auto &job : jobs)
+            Run(job);
+        return;
+    }
+
+    // every arena is thread local, the workers take the next free job
+    atomic<size_t> next(0);
+    vector<thread> workers;
+    workers.reserve(threads);
+
+    for (uint32_t ii = 0; ii < threads; ++ii)
+        workers.emplace_back([this, &jobs, &next]()
+                             {
+                                 for (size_t job = next++; job < jobs.size(); job = next++)
+                                     Run(jobs[job]);
+                             });
+
+    for (auto &worker : workers)
+        worker.join();
+}
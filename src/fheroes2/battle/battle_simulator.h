@@ -0,0 +1,65 @@
+/***************************************************************************
+ *   Copyright (C) 2012 by Andrey Afletdinov <fheroes2@gmail.com>          *
+ *                                                                         *
+ *   Part of the Free Heroes2 Engine:                                      *
+ *   http://sourceforge.net/projects/fheroes2                              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#pragma once
+
+#include <vector>
+
+#include "battle.h"
+
+class Army;
+
+namespace Battle
+{
+    /* one battle for the simulator; the armies belong to the caller and take the losses */
+    struct SimulatorJob
+    {
+        SimulatorJob() : army1(nullptr), army2(nullptr), mapsindex(-1), seed(0), turns(0)
+        {}
+
+        SimulatorJob(Army &a1, Army &a2, s32 index = -1, uint32_t rnd = 0) :
+                army1(&a1), army2(&a2), mapsindex(index), seed(rnd), turns(0)
+        {}
+
+        Army *army1;
+        Army *army2;
+        s32 mapsindex;  // battle tile, -1 for an open field without the world map
+        uint32_t seed;  // the same seed and armies give the same battle
+        Result result;
+        uint32_t turns;
+    };
+
+    /* full battle rules with both sides under AI control: no interface, sound or input */
+    class Simulator
+    {
+    public:
+        explicit Simulator(uint32_t maxturns = 100);
+
+        void Run(SimulatorJob &) const;
+
+        /* jobs spread over worker threads, 0 for one per core; jobs must not share armies or commanders */
+        void RunBatch(vector<SimulatorJob> &, uint32_t threads = 0) const;
+
+    private:
+        uint32_t maxturns;
+    };
+}
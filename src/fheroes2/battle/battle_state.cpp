@@ -0,0 +1,86 @@
+/***************************************************************************
+ *   Copyright (C) 2012 by Andrey Afletdinov <fheroes2@gmail.com>          *
+ *                                                                         *
+ *   Part of the Free Heroes2 Engine:                                      *
+ *   http://sourceforge.net/projects/fheroes2                              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include <type_traits>
+
+#include "battle_arena.h"
+#include "battle_army.h"
+#include "battle_troop.h"
+#include "battle_state.h"
+
+static_assert(std::is_trivially_copyable<Battle::State>::value, "battle state is copied as plain memory");
+
+Battle::State::State() : size(0), turn(0), color(0)
+{
+}
+
+int Battle::State::Find(uint32_t id) const
+{
+    for (uint32_t ii = 0; ii < size; ++ii)
+        if (uid[ii] == id) return ii;
+
+    return -1;
+}
+
+bool Battle::State::Capture(const Arena &arena)
+{
+    const Force *forces[] = {&arena.GetForce1(), &arena.GetForce2()};
+
+    size = 0;
+
+    for (int side = 0; side < 2; ++side)
+    {
+        force_modes[side] = (*forces[side])();
+
+        for (const Unit *unit : *forces[side])
+        {
+            if (STATEUNITS == size || STATEAFFECTED < unit->affected.size()) return false;
+
+            uid[size] = unit->uid;
+            count[size] = unit->GetCount();
+            hp[size] = unit->hp;
+            dead[size] = unit->dead;
+            shots[size] = unit->shots;
+            disruptingray[size] = unit->disruptingray;
+            modes[size] = unit->BitModes::operator()();
+            head[size] = unit->GetHeadIndex();
+            reflect[size] = unit->reflect;
+
+            affected[size] = unit->affected.size();
+            for (uint32_t ii = 0; ii < affected[size]; ++ii)
+            {
+                affected_modes[size][ii] = unit->affected[ii].first;
+                affected_durations[size][ii] = unit->affected[ii].second;
+            }
+
+            ++size;
+        }
+    }
+
+    for (const Cell &cell : arena.board)
+        objects[cell.GetIndex()] = cell.GetObject();
+
+    turn = arena.current_turn;
+    color = arena.current_color;
+
+    return true;
+}
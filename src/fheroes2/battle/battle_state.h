@@ -0,0 +1,69 @@
+/***************************************************************************
+ *   Copyright (C) 2012 by Andrey Afletdinov <fheroes2@gmail.com>          *
+ *                                                                         *
+ *   Part of the Free Heroes2 Engine:                                      *
+ *   http://sourceforge.net/projects/fheroes2                              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#pragma once
+
+#include "battle_board.h"
+
+namespace Battle
+{
+    class Arena;
+
+    enum
+    {
+        STATEUNITS = 32, STATEAFFECTED = 8
+    };
+
+    /* the rules state of a battle in flat arrays: what the units, forces and board change while
+       fighting, without contours, animation or interface; the search input, a snapshot is a plain copy */
+    struct State
+    {
+        State();
+
+        /* false if the battle has more units or spell effects than the arrays hold */
+        bool Capture(const Arena &);
+
+        int Find(uint32_t uid) const;
+
+        uint32_t size;
+
+        uint32_t uid[STATEUNITS];
+        uint32_t count[STATEUNITS];
+        uint32_t hp[STATEUNITS];
+        uint32_t dead[STATEUNITS];
+        uint32_t shots[STATEUNITS];
+        uint32_t disruptingray[STATEUNITS];
+        uint32_t modes[STATEUNITS];
+        s8 head[STATEUNITS];
+        bool reflect[STATEUNITS];
+
+        u8 affected[STATEUNITS];
+        uint32_t affected_modes[STATEUNITS][STATEAFFECTED];
+        uint32_t affected_durations[STATEUNITS][STATEAFFECTED];
+
+        uint32_t force_modes[2];
+        u8 objects[ARENASIZE];
+
+        uint32_t turn;
+        int color;
+    };
+}
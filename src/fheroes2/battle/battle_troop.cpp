@@ -210,7 +210,7 @@ uint32_t Battle::ModesAffected::FindZeroDuration() const
 }
 
 Battle::Unit::Unit(const Troop &t, s32 pos, bool ref) : ArmyTroop(nullptr, t),
-                                                        uid(World::GetUniq()), hp(Monster::GetHitPoints(t)),
+                                                        uid(GetArena()->GetUniq()), hp(Monster::GetHitPoints(t)),
                                                         count0(t.GetCount()), dead(0), shots(t.GetShots()),
                                                         disruptingray(0), reflect(ref), animstate(0), animframe(0),
                                                         animstep(1), mirror(nullptr), blindanswer(false)
@@ -314,23 +314,13 @@ string Battle::Unit::GetSpeedString() const
     return os.str();
 }
 
+/* shared with every unit of the monster, rendered on first hover */
 Surface Battle::Unit::GetContour(int val) const
 {
-    switch (val)
-    {
-        case CONTOUR_MAIN:
-            return contours[0];
-        case CONTOUR_REFLECT:
-            return contours[1];
-        case CONTOUR_BLACK:
-            return contours[2];
-        case CONTOUR_BLACK | CONTOUR_REFLECT:
-            return contours[3];
-        default:
-            break;
-    }
+    const monstersprite_t &msi = GetMonsterSprite();
 
-    return Surface();
+    return AGG::GetICNEffect(msi.icn_file, msi.frm_idle.start, val & CONTOUR_REFLECT,
+                             val & CONTOUR_BLACK ? AGG::EFFECT_GRAYSCALE : AGG::EFFECT_CONTOUR);
 }
 
 uint32_t Battle::Unit::GetDead() const
@@ -368,23 +358,6 @@ const Battle::monstersprite_t &Battle::Unit::GetMonsterSprite() const
     return monsters_info[GetID()];
 }
 
-void Battle::Unit::InitContours()
-{
-    const monstersprite_t &msi = GetMonsterSprite();
-    const Sprite &sprite1 = AGG::GetICN(msi.icn_file, msi.frm_idle.start, false);
-    const Sprite &sprite2 = AGG::GetICN(msi.icn_file, msi.frm_idle.start, true);
-
-    // main sprite
-    contours[0] = sprite1.RenderContour(RGBA(0xe0, 0xe0, 0));
-
-    // revert sprite
-    contours[1] = sprite2.RenderContour(RGBA(0xe0, 0xe0, 0));
-
-    // create white black sprite
-    contours[2] = sprite1.RenderGrayScale();
-    contours[3] = sprite2.RenderGrayScale();
-}
-
 void Battle::Unit::SetMirror(Unit *ptr)
 {
     mirror = ptr;
@@ -415,22 +388,22 @@ void Battle::Unit::SetRandomMorale()
     switch (GetMorale())
     {
         case Morale::TREASON:
-            if (9 > Rand::Get(1, 16)) SetModes(MORALE_BAD);
+            if (9 > Arena::GetRandom().Get(1, 16)) SetModes(MORALE_BAD);
             break;     // 50%
         case Morale::AWFUL:
-            if (6 > Rand::Get(1, 15)) SetModes(MORALE_BAD);
+            if (6 > Arena::GetRandom().Get(1, 15)) SetModes(MORALE_BAD);
             break;     // 30%
         case Morale::POOR:
-            if (2 > Rand::Get(1, 15)) SetModes(MORALE_BAD);
+            if (2 > Arena::GetRandom().Get(1, 15)) SetModes(MORALE_BAD);
             break;     // 15%
         case Morale::GOOD:
-            if (2 > Rand::Get(1, 15)) SetModes(MORALE_GOOD);
+            if (2 > Arena::GetRandom().Get(1, 15)) SetModes(MORALE_GOOD);
             break;    // 15%
         case Morale::GREAT:
-            if (6 > Rand::Get(1, 15)) SetModes(MORALE_GOOD);
+            if (6 > Arena::GetRandom().Get(1, 15)) SetModes(MORALE_GOOD);
             break;    // 30%
         case Morale::BLOOD:
-            if (9 > Rand::Get(1, 16)) SetModes(MORALE_GOOD);
+            if (9 > Arena::GetRandom().Get(1, 16)) SetModes(MORALE_GOOD);
             break;    // 50%
         default:
             break;
@@ -447,22 +420,22 @@ void Battle::Unit::SetRandomLuck()
     switch (f)
     {
         case Luck::CURSED:
-            if (9 > Rand::Get(1, 16)) SetModes(LUCK_BAD);
+            if (9 > Arena::GetRandom().Get(1, 16)) SetModes(LUCK_BAD);
             break;       // 50%
         case Luck::AWFUL:
-            if (6 > Rand::Get(1, 15)) SetModes(LUCK_BAD);
+            if (6 > Arena::GetRandom().Get(1, 15)) SetModes(LUCK_BAD);
             break;       // 30%
         case Luck::BAD:
-            if (2 > Rand::Get(1, 15)) SetModes(LUCK_BAD);
+            if (2 > Arena::GetRandom().Get(1, 15)) SetModes(LUCK_BAD);
             break;       // 15%
         case Luck::GOOD:
-            if (2 > Rand::Get(1, 15)) SetModes(LUCK_GOOD);
+            if (2 > Arena::GetRandom().Get(1, 15)) SetModes(LUCK_GOOD);
             break;      // 15%
         case Luck::GREAT:
-            if (6 > Rand::Get(1, 15)) SetModes(LUCK_GOOD);
+            if (6 > Arena::GetRandom().Get(1, 15)) SetModes(LUCK_GOOD);
             break;      // 30%
         case Luck::IRISH:
-            if (9 > Rand::Get(1, 16)) SetModes(LUCK_GOOD);
+            if (9 > Arena::GetRandom().Get(1, 16)) SetModes(LUCK_GOOD);
             break;      // 50%
         default:
             break;
@@ -499,13 +472,19 @@ bool Battle::Unit::isHandFighting() const
 {
     if (GetCount() && !Modes(CAP_TOWER))
     {
-        const Indexes around = Board::GetAroundIndexes(*this);
-
-        for (int it : around)
+        // own cells hold no enemy, no need to skip them
+        for (const s32 it : Board::GetAroundSpan(GetHeadIndex()))
         {
             const Unit *enemy = Board::GetCell(it)->GetUnit();
             if (enemy && enemy->GetColor() != GetColor()) return true;
         }
+
+        if (isWide())
+            for (const s32 it : Board::GetAroundSpan(GetTailIndex()))
+            {
+                const Unit *enemy = Board::GetCell(it)->GetUnit();
+                if (enemy && enemy->GetColor() != GetColor()) return true;
+            }
     }
 
     return false;
@@ -664,7 +643,7 @@ uint32_t Battle::Unit::GetDamage(const Unit &enemy) const
     else if (Modes(SP_CURSE))
         res = GetDamageMin(enemy);
     else
-        res = Rand::Get(GetDamageMin(enemy), GetDamageMax(enemy));
+        res = Arena::GetRandom().Get(GetDamageMin(enemy), GetDamageMax(enemy));
 
     if (Modes(LUCK_GOOD)) res <<= 1; // mul 2
     else if (Modes(LUCK_BAD)) res >>= 1; // div 2
@@ -798,7 +777,7 @@ uint32_t Battle::Unit::ApplyDamage(Unit &enemy, uint32_t dmg)
         case GENIE:
             // 10% half
             if (1 < GetCount() && killed < GetCount() &&
-                genie_enemy_half_percent >= Rand::Get(1, 100))
+                genie_enemy_half_percent >= Arena::GetRandom().Get(1, 100))
             {
                 killed = ApplyDamage(hp / 2);
 
@@ -1059,7 +1038,7 @@ void Battle::Unit::PostAttackAction(Unit &enemy)
     {
         case ARCHMAGE:
             // 20% clean magic state
-            if (enemy.isValid() && enemy.Modes(IS_GOOD_MAGIC) && 3 > Rand::Get(1, 10)) enemy.ResetModes(IS_GOOD_MAGIC);
+            if (enemy.isValid() && enemy.Modes(IS_GOOD_MAGIC) && 3 > Arena::GetRandom().Get(1, 10)) enemy.ResetModes(IS_GOOD_MAGIC);
             break;
 
         default:
@@ -1762,34 +1741,34 @@ int Battle::Unit::GetSpellMagic(bool force) const
     {
         case UNICORN:
             // 20% blind
-            if (force || 3 > Rand::Get(1, 10)) return Spell::BLIND;
+            if (force || 3 > Arena::GetRandom().Get(1, 10)) return Spell::BLIND;
             break;
 
         case CYCLOPS:
             // 20% paralyze
-            if (force || 3 > Rand::Get(1, 10)) return Spell::PARALYZE;
+            if (force || 3 > Arena::GetRandom().Get(1, 10)) return Spell::PARALYZE;
             break;
 
         case MUMMY:
             // 20% curse
-            if (force || 3 > Rand::Get(1, 10)) return Spell::CURSE;
+            if (force || 3 > Arena::GetRandom().Get(1, 10)) return Spell::CURSE;
             break;
 
         case ROYAL_MUMMY:
             // 30% curse
-            if (force || 4 > Rand::Get(1, 10)) return Spell::CURSE;
+            if (force || 4 > Arena::GetRandom().Get(1, 10)) return Spell::CURSE;
             break;
 
             /* skip: see Unit::PostAttackAction
 	case Monster::ARCHMAGE:
             // 20% dispel
-            if(!force && 3 > Rand::Get(1, 10)) return Spell::DISPEL;
+            if(!force && 3 > Arena::GetRandom().Get(1, 10)) return Spell::DISPEL;
             break;
 	*/
 
         case MEDUSA:
             // 20% stone
-            if (force || 3 > Rand::Get(1, 10)) return Spell::STONE;
+            if (force || 3 > Arena::GetRandom().Get(1, 10)) return Spell::STONE;
             break;
 
         default:
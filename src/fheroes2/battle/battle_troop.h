@@ -99,8 +99,6 @@ namespace Battle
 
         Surface GetContour(int) const;
 
-        void InitContours();
-
         void SetMirror(Unit *);
 
         void SetRandomMorale();
@@ -273,6 +271,8 @@ namespace Battle
         friend ByteVectorWriter &operator<<(ByteVectorWriter &, const Unit &);
 
         friend ByteVectorReader &operator>>(ByteVectorReader &, Unit &);
+
+        friend struct State;
         
         uint32_t uid;
         uint32_t hp;
@@ -289,7 +289,6 @@ namespace Battle
         Position position;
         ModesAffected affected;
         Unit *mirror;
-        Surface contours[4];
 
         bool blindanswer;
     };
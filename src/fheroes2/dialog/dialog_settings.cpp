@@ -250,6 +250,7 @@ void Dialog::ExtSettings(bool readonly)
     states.push_back(Settings::BATTLE_MAGIC_TROOP_RESIST);
     states.push_back(Settings::BATTLE_SKIP_INCREASE_DEFENSE);
     states.push_back(Settings::BATTLE_REVERSE_WAIT_ORDER);
+    states.push_back(Settings::BATTLE_RECORD_REPLAYS);
 
     SettingsListBox listbox(area, readonly);
 
@@ -28,6 +28,7 @@
 #include "agg.h"
 #include "cursor.h"
 #include "game.h"
+#include "game_io.h"
 #include "display.h"
 #include "system.h"
 #include "tools.h"
@@ -35,6 +36,8 @@
 #include "audio_mixer.h"
 #include "audio_music.h"
 #include "icn.h"
+#include "battle_replay.h"
+#include "game_autoplay.h"
 
 void LoadZLogo();
 
@@ -57,6 +60,12 @@ int PrintHelp(const char *basename)
     COUT("  -d\tdebug mode");
 #endif
     COUT("  -h\tprint this help and exit");
+    COUT("  -l\tsaved game of a battle replay");
+    COUT("  -r\tplay the battle replay and exit");
+    COUT("  -f\treplay without animation delays");
+    COUT("  -a\tplay a map or a saved game headless, every color under AI control");
+    COUT("  -n\tdays of the headless play, default 28");
+    COUT("  -s\trandom seed of the headless play, default 1");
 
     return EXIT_SUCCESS;
 }
@@ -169,6 +178,36 @@ int main(int argc, char **argv)
             }
     }
 
+    // battle replay on the saved game it was recorded in
+    string replay_file;
+    string replay_save;
+    bool replay_turbo = false;
+
+    // headless AI autoplay
+    string autoplay_file;
+    uint32_t autoplay_days = 28;
+    uint32_t autoplay_seed = 1;
+
+    for (size_t ii = 1; ii < vArgv.size(); ++ii)
+    {
+        if (vArgv[ii] == "-r" && ii + 1 < vArgv.size())
+            replay_file = vArgv[++ii];
+        else if (vArgv[ii] == "-l" && ii + 1 < vArgv.size())
+            replay_save = vArgv[++ii];
+        else if (vArgv[ii] == "-f")
+            replay_turbo = true;
+        else if (vArgv[ii] == "-a" && ii + 1 < vArgv.size())
+            autoplay_file = vArgv[++ii];
+        else if (vArgv[ii] == "-n" && ii + 1 < vArgv.size())
+            autoplay_days = GetInt(vArgv[++ii]);
+        else if (vArgv[ii] == "-s" && ii + 1 < vArgv.size())
+            autoplay_seed = GetInt(vArgv[++ii]);
+    }
+
+    // no video, sound and game data
+    if (!autoplay_file.empty())
+        return Game::Autoplay::Run(autoplay_file, autoplay_days, autoplay_seed);
+
     if (!conf.SelectVideoDriver().empty()) SetVideoDriver(conf.SelectVideoDriver());
 
     // random init
@@ -243,6 +282,17 @@ int main(int argc, char **argv)
         // init game data
         Game::Init();
 
+        if (!replay_file.empty())
+        {
+            if (replay_save.empty() || !Game::Load(replay_save))
+            {
+                ERROR("cannot load saved game of the replay: " << replay_save);
+                return EXIT_FAILURE;
+            }
+
+            return Battle::PlayReplay(replay_file, true, replay_turbo) ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+
         int test = 0;
 
         // goto main menu
@@ -307,6 +307,8 @@ uint32_t Game::GetGameOverScores()
 
 void Game::ShowLoadMapsText()
 {
+    if (Settings::Get().Headless()) return;
+
     Display &display = Display::Get();
     const Rect pos(0, display.h() / 2, display.w(), display.h() / 2);
     TextBox text(_("Maps Loading..."), Font::BIG, pos.w);
@@ -477,7 +479,7 @@ void Game::PlayPickupSound()
 {
     int wav = M82::UNKNOWN;
 
-    switch (Rand::Get(1, 7))
+    switch (Rand::Cosmetic().Get(1, 7))
     {
         case 1:
             wav = M82::PICKUP01;
@@ -0,0 +1,194 @@
+/***************************************************************************
+ *   Copyright (C) 2012 by Andrey Afletdinov <fheroes2@gmail.com>          *
+ *                                                                         *
+ *   Part of the Free Heroes2 Engine:                                      *
+ *   http://sourceforge.net/projects/fheroes2                              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+
+#include "settings.h"
+#include "world.h"
+#include "kingdom.h"
+#include "heroes.h"
+#include "castle.h"
+#include "game.h"
+#include "game_io.h"
+#include "game_autoplay.h"
+#include "game_headless.h"
+#include "ai.h"
+#include "system.h"
+#include "tools.h"
+
+namespace
+{
+    double timer_ms[Game::Autoplay::TIMERS];
+    uint32_t timer_calls[Game::Autoplay::TIMERS];
+
+    /* the troops of every army slot */
+    void HashArmy(Game::Headless::Checksum &checksum, const Army &army)
+    {
+        for (size_t ii = 0; ii < army.m_troops.Size(); ++ii)
+        {
+            const Troop *troop = army.m_troops.GetTroop(ii);
+            checksum.Hash(troop && troop->isValid() ? troop->GetID() : 0);
+            checksum.Hash(troop && troop->isValid() ? troop->GetCount() : 0);
+        }
+    }
+
+    /* everything the AI decisions leave on the map */
+    string WorldChecksum()
+    {
+        Game::Headless::Checksum checksum;
+
+        checksum.Hash(world.CountDay());
+
+        for (const auto &tile : world.vec_tiles)
+        {
+            checksum.Hash(tile.GetObject(false));
+            checksum.Hash(tile.GetQuantity1());
+            checksum.Hash(tile.GetQuantity2());
+        }
+
+        for (const Heroes *hero : world.vec_heroes._items)
+        {
+            checksum.Hash(hero->GetColor());
+            checksum.Hash(hero->GetIndex());
+            checksum.Hash(hero->GetExperience());
+            checksum.Hash(hero->GetMovePoints());
+            HashArmy(checksum, hero->GetArmy());
+        }
+
+        for (const Castle *castle : world.vec_castles)
+        {
+            checksum.Hash(castle->GetColor());
+            HashArmy(checksum, castle->GetArmy());
+        }
+
+        for (int color : Colors(Color::ALL))
+        {
+            const Funds &funds = world.GetKingdom(color).GetFunds();
+
+            checksum.Hash(funds.wood);
+            checksum.Hash(funds.mercury);
+            checksum.Hash(funds.ore);
+            checksum.Hash(funds.sulfur);
+            checksum.Hash(funds.crystal);
+            checksum.Hash(funds.gems);
+            checksum.Hash(funds.gold);
+        }
+
+        return checksum.String();
+    }
+}
+
+Game::Autoplay::Timer::Timer(int t) : timer(t), active(Settings::Get().Headless())
+{
+    if (active) start = std::chrono::steady_clock::now();
+}
+
+Game::Autoplay::Timer::~Timer()
+{
+    if (!active) return;
+
+    timer_ms[timer] += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    ++timer_calls[timer];
+}
+
+int Game::Autoplay::Run(const string &file, uint32_t days, uint32_t seed)
+{
+    Settings &conf = Settings::Get();
+
+    conf.SetHeadless(true);
+    conf.ResetSound();
+    conf.ResetMusic();
+
+    // the map generation, the AI and the battle seeds use the global generator
+    srand(seed);
+
+    const string ext = StringLower(file.size() > 4 ? file.substr(file.size() - 4) : file);
+    const bool saved = ext == ".sav";
+
+    if (saved ? !Game::Load(file) : !Headless::LoadMap(file))
+    {
+        ERROR("cannot load: " << file);
+        return EXIT_FAILURE;
+    }
+
+    const Players &players = conf.GetPlayers();
+
+    for (auto it : players._items)
+        if (it) it->SetControl(CONTROL_AI);
+
+    fill(timer_ms, timer_ms + TIMERS, 0.0);
+    fill(timer_calls, timer_calls + TIMERS, 0u);
+
+    // a saved game goes on with the turn of its current color
+    bool skip_turns = saved;
+    const uint32_t first_day = world.CountDay();
+    uint32_t turns = 0;
+    uint32_t heroes = 0;
+
+    for (uint32_t day = 0; day < days; ++day)
+    {
+        if (!skip_turns) world.NewDay();
+
+        for (auto it : players._items)
+        {
+            if (!it)
+                continue;
+            const Player &player = (*it);
+            Kingdom &kingdom = world.GetKingdom(player.GetColor());
+
+            if (!kingdom.isPlay() ||
+                (skip_turns && !player.isColor(conf.CurrentColor())))
+                continue;
+
+            skip_turns = false;
+            conf.SetCurrentColor(player.GetColor());
+            world.ClearFog(player.GetColor());
+            kingdom.ActionBeforeTurn();
+
+            {
+                Timer timer(KINGDOM);
+                AI::KingdomTurn(kingdom);
+            }
+
+            ++turns;
+            heroes += kingdom.GetHeroes()._items.size();
+        }
+
+        skip_turns = false;
+
+        // one kingdom left
+        if (1 >= Color::Count(world.vec_kingdoms.GetNotLossColors()))
+            break;
+    }
+
+    COUT(System::GetBasename(file) << ": days: " << world.CountDay() - first_day <<
+         ", ai turns: " << turns <<
+         ", ms/turn: " << timer_ms[KINGDOM] / max<uint32_t>(turns, 1) <<
+         ", ms/hero: " << timer_ms[HERO] / max<uint32_t>(heroes, 1) <<
+         ", battles: " << timer_calls[BATTLE] <<
+         ", ms/battle: " << timer_ms[BATTLE] / max<uint32_t>(timer_calls[BATTLE], 1) <<
+         ", checksum: " << WorldChecksum());
+
+    return EXIT_SUCCESS;
+}
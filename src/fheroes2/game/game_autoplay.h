@@ -0,0 +1,57 @@
+/***************************************************************************
+ *   Copyright (C) 2012 by Andrey Afletdinov <fheroes2@gmail.com>          *
+ *                                                                         *
+ *   Part of the Free Heroes2 Engine:                                      *
+ *   http://sourceforge.net/projects/fheroes2                              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#pragma once
+
+#include <chrono>
+#include <string>
+
+#include "types.h"
+
+namespace Game
+{
+    namespace Autoplay
+    {
+        enum
+        {
+            KINGDOM, HERO, BATTLE, TIMERS
+        };
+
+        /* adds the time of its scope to an autoplay timer; does nothing outside of the headless mode */
+        class Timer
+        {
+        public:
+            explicit Timer(int);
+
+            ~Timer();
+
+        private:
+            int timer;
+            bool active;
+            std::chrono::steady_clock::time_point start;
+        };
+
+        /* plays a map or a saved game for the days with every color under AI control and
+           no display, prints the AI timings and the world checksum */
+        int Run(const string &file, uint32_t days, uint32_t seed);
+    }
+}
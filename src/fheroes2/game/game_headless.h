@@ -0,0 +1,64 @@
+/***************************************************************************
+ *   Copyright (C) 2012 by Andrey Afletdinov <fheroes2@gmail.com>          *
+ *                                                                         *
+ *   Part of the Free Heroes2 Engine:                                      *
+ *   http://sourceforge.net/projects/fheroes2                              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#pragma once
+
+#include <iomanip>
+#include <sstream>
+#include <string>
+
+#include "types.h"
+
+namespace Game
+{
+    /* what the autoplay and the benchmarks share to run without the interface */
+    namespace Headless
+    {
+        /* FNV-1a over 32 bit values */
+        struct Checksum
+        {
+            Checksum() : value(2166136261u)
+            {}
+
+            void Hash(uint32_t data)
+            {
+                for (int ii = 0; ii < 4; ++ii)
+                {
+                    value ^= (data >> (ii * 8)) & 0xFF;
+                    value *= 16777619u;
+                }
+            }
+
+            string String() const
+            {
+                ostringstream os;
+                os << hex << setw(8) << setfill('0') << value;
+                return os.str();
+            }
+
+            uint32_t value;
+        };
+
+        /* load the map as a new game, without a current color */
+        bool LoadMap(const string &file);
+    }
+}
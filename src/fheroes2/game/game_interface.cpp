@@ -174,6 +174,13 @@ void Interface::Basic::Redraw(int force)
 {
     Settings &conf = Settings::Get();
 
+    // autoplay has no display
+    if (conf.Headless())
+    {
+        redraw = 0;
+        return;
+    }
+
     if ((redraw | force) & REDRAW_GAMEAREA) gameArea.Redraw(Display::Get(), LEVEL_ALL);
 
     if ((conf.ExtGameHideInterface() && conf.ShowRadar()) || ((redraw | force) & REDRAW_RADAR)) radar.Redraw();
@@ -272,6 +272,22 @@ Heroes::Heroes(int heroid, int rc) : HeroBase(HEROES, rc), ColorBase(Color::NONE
     move_point = GetMaxMovePoints();
 }
 
+void Heroes::SetCenter(const Point &pt)
+{
+    const Point from = GetCenter();
+
+    MapPosition::SetCenter(pt);
+    world.positions_index.MoveHero(*this, from);
+}
+
+void Heroes::SetIndex(s32 index)
+{
+    const Point from = GetCenter();
+
+    MapPosition::SetIndex(index);
+    world.positions_index.MoveHero(*this, from);
+}
+
 void Heroes::LoadFromMP2(s32 map_index, int cl, int rc, ByteVectorReader &st)
 {
     // reset modes
@@ -167,6 +167,11 @@ public:
 
     void SetMapsObject(int);
 
+    /* move the hero, the world positions index follows */
+    void SetCenter(const Point &);
+
+    void SetIndex(s32);
+
     const Point &GetCenterPatrol() const;
 
     void SetCenterPatrol(const Point &);
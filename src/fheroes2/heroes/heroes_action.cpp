@@ -437,6 +437,9 @@ void Heroes::Action(s32 dst_index)
     if (GetKingdom().isControlAI())
         return AI::HeroesAction(*this, dst_index);
 
+    // pickups, fights and quantities
+    world.TileChanged(dst_index);
+
     const Maps::Tiles &tile = world.GetTiles(dst_index);
     const int object = (dst_index == GetIndex() ?
                         tile.GetObject(false) : tile.GetObject());
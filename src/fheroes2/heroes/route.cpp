@@ -23,6 +23,7 @@
 #include "world.h"
 #include "game.h"
 #include "settings.h"
+#include "ai_profiler.h"
 #include <sstream>
 #include <iostream>
 
@@ -117,9 +118,17 @@ s32 Route::Path::GetDestinedIndex() const
 /* return length path */
 bool Route::Path::Calculate(const s32 &dst_index, int limit /* -1 */)
 {
+    LocalEvent::Get().HandleEvents(false);
+
+    return Plan(dst_index, limit);
+}
+
+bool Route::Path::Plan(const s32 &dst_index, int limit /* -1 */)
+{
+    AI::Profiler::Scope scope(AI::Profiler::PATH);
     dst = dst_index;
 
-    if (Find(dst, limit))
+    if (Find(hero->GetIndex(), dst, limit))
     {
         // check monster dst
         if (Maps::isValidAbsIndex(dst) &&
@@ -127,6 +136,7 @@ bool Route::Path::Calculate(const s32 &dst_index, int limit /* -1 */)
             pop_back();
     }
 
+    AI::Profiler::Count(empty() ? AI::Profiler::PATHS_FAILED : AI::Profiler::PATHS_FOUND);
     return !empty();
 }
 
@@ -500,11 +510,61 @@ bool Route::Path::hasObstacle() const
     return it != end() && (*it).GetIndex() != GetLastIndex();
 }
 
+/* replan only the blocked part of the route: from the step before the obstacle to the first safe step after it */
+bool Route::Path::RepairObstacle(iterator it)
+{
+    const s32 from = (*it).GetFrom();
+    const s32 last = GetLastIndex();
+
+    // rejoin point: first step past the obstacle, outside of any monster protection
+    iterator rejoin = it;
+    int length = 1;
+    while (rejoin != end() && (*rejoin).GetIndex() != last &&
+           (StepIsObstacle(*rejoin) || Maps::TileIsUnderProtection((*rejoin).GetIndex())))
+    {
+        ++rejoin;
+        ++length;
+    }
+
+    if (rejoin == end() || StepIsObstacle(*rejoin))
+        return false;
+
+    const s32 to = (*rejoin).GetIndex();
+
+    Path patch(*hero);
+    if (!patch.Find(from, to, 2 * length + 8))
+        return false;
+
+    const uint32_t expanded = GetLastExpanded();
+
+    erase(it, ++rejoin);
+    splice(rejoin, patch);
+
+    if (IS_DEBUG(DBG_GAME, DBG_TRACE))
+    {
+        Path full(*hero);
+        full.Find(hero->GetIndex(), dst);
+        const uint32_t expandedFull = GetLastExpanded();
+        VERBOSE(hero->GetName() << ", repair from: " << from << ", to: " << to << ", expanded: " << expanded <<
+                ", full: " << expandedFull << ", saved: " <<
+                (expandedFull > expanded ? expandedFull - expanded : 0));
+    }
+
+    return true;
+}
+
 void Route::Path::RescanObstacle()
 {
     // scan obstacle
     iterator it = find_if(begin(), end(), StepIsObstacle);
 
+    // patch every blocked step, a path with many of them is cheaper to search again
+    for (int repairs = 0; it != end() && (*it).GetIndex() != GetLastIndex() && repairs < 4; ++repairs)
+    {
+        if (!RepairObstacle(it)) break;
+        it = find_if(begin(), end(), StepIsObstacle);
+    }
+
     if (it != end() && (*it).GetIndex() != GetLastIndex())
     {
         size_t size1 = size();
@@ -63,6 +63,29 @@ namespace Route
         uint32_t penalty;
     };
 
+    struct PathMap;
+
+    class Pathfinder
+    {
+    public:
+        Pathfinder();
+
+        ~Pathfinder();
+
+        bool Find(const Heroes &, s32 from, s32 to, int limit, list<Step> &);
+
+        uint32_t GetExpanded() const
+        { return expanded; }
+
+    private:
+        Pathfinder(const Pathfinder &) = delete;
+
+        Pathfinder &operator=(const Pathfinder &) = delete;
+
+        up<PathMap> cells;
+        uint32_t expanded;
+    };
+
     class Path : public list<Step>
     {
     public:
@@ -86,6 +109,9 @@ namespace Route
 
         bool Calculate(const s32 &, int limit = -1);
 
+        /* Calculate without the event pump, for the AI planning threads */
+        bool Plan(const s32 &, int limit = -1);
+
         void Show()
         { hide = false; }
 
@@ -117,8 +143,12 @@ namespace Route
 
         static int GetIndexSprite(int from, int to, int mod);
 
+        static uint32_t GetLastExpanded();
+
     private:
-        bool Find(s32, int limit = -1);
+        bool Find(s32 from, s32 to, int limit = -1);
+
+        bool RepairObstacle(iterator);
 
         friend ByteVectorWriter &operator<<(ByteVectorWriter &, const Path &);
 
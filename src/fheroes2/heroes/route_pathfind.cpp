@@ -222,9 +222,8 @@ uint32_t GetPenaltyFromTo(s32 from, s32 to, int direct, int pathfinding)
     return (cost1 + cost2) >> 1;
 }
 
-namespace
+namespace Route
 {
-
     struct RowInMap
     {
         int Key;
@@ -244,10 +243,7 @@ namespace
         void clear()
         {
             mask = (1 << _sizePow2) - 1;
-            _jumpTable.clear();
-            _jumpTable.reserve(mask + 1);
-            for (int i = 0; i <= mask; i++)
-                _jumpTable[i] = -1;
+            _jumpTable.assign(mask + 1, -1);
             _rows.clear();
         }
 
@@ -294,8 +290,6 @@ namespace
         }
     };
 
-    PathMap pathPointsMap2;
-
     int GetCurrentLength(PathMap &list, s32 from)
     {
         int res = 0;
@@ -309,39 +303,73 @@ namespace
 
 }
 
-bool Route::Path::Find(s32 to, int limit)
+namespace
+{
+    // every thread searches in its own scratch memory
+    Route::Pathfinder &GetPathfinder()
+    {
+        static thread_local Route::Pathfinder pathfinder;
+        return pathfinder;
+    }
+}
+
+Route::Pathfinder::Pathfinder() : cells(new PathMap), expanded(0)
+{
+}
+
+Route::Pathfinder::~Pathfinder()
+{
+}
+
+uint32_t Route::Path::GetLastExpanded()
+{
+    return GetPathfinder().GetExpanded();
+}
+
+bool Route::Path::Find(s32 from, s32 to, int limit)
+{
+    return GetPathfinder().Find(*hero, from, to, limit, *this);
+}
+
+/* search only reads the world: the event pump and all world changes stay outside */
+bool Route::Pathfinder::Find(const Heroes &hero, s32 from, s32 to, int limit, list<Step> &path)
 {
-    const int pathfinding = hero->GetLevelSkill(Skill::Secondary::PATHFINDING);
-    const s32 from = hero->GetIndex();
+    path.clear();
+    expanded = 0;
+
+    // target on another landmass or sea
+    if (!world.isReachableRegion(from, to))
+        return false;
+
+    const int pathfinding = hero.GetLevelSkill(Skill::Secondary::PATHFINDING);
 
     s32 cur = from;
     s32 alt = 0;
     s32 tmp = 0;
 
-    pathPointsMap2.clear();
-    auto it1_2 = pathPointsMap2._rows.begin();
-    auto it2_2 = pathPointsMap2._rows.end();
+    cells->clear();
+    auto it1_2 = cells->_rows.begin();
+    auto it2_2 = cells->_rows.end();
 
-    cell_t& currCell = pathPointsMap2.get(cur);
+    cell_t& currCell = cells->get(cur);
     currCell.cost_g = 0;
     currCell.cost_t = 0;
     currCell.parent = -1;
     currCell.open = 0;
 
-    const Directions directions = Direction::All();
-    clear();
+    const Directions &directions = Direction::All();
 
     Size wSize(world.w(), world.h());
-    LocalEvent::Get().HandleEvents(false);
     while (cur != to)
     {
+        ++expanded;
         for (auto &direction : directions)
         {
             if (!Maps::isValidDirection(cur, direction, wSize))
                 continue;
             tmp = Maps::GetDirectionIndex(cur, direction);
-            auto &tmpItem2 = pathPointsMap2.get(tmp);
-            auto &curItem2 = pathPointsMap2.get(cur);
+            auto &tmpItem2 = cells->get(tmp);
+            auto &curItem2 = cells->get(cur);
 
             if (!tmpItem2.open) continue;
             const uint32_t costg = GetPenaltyFromTo(cur, tmp, direction, pathfinding);
@@ -350,7 +378,7 @@ bool Route::Path::Find(s32 to, int limit)
             if (-1 == tmpItem2.parent)
             {
                 if ((curItem2.passbl & direction) ||
-                    PassableFromToTile(*hero, cur, tmp, direction, to))
+                    PassableFromToTile(hero, cur, tmp, direction, to))
                 {
                     curItem2.passbl |= direction;
 
@@ -376,7 +404,7 @@ bool Route::Path::Find(s32 to, int limit)
             {
 
                 if (tmpItem2.cost_t > curItem2.cost_t + costg &&
-                    ((curItem2.passbl & direction) || PassableFromToTile(*hero, cur, tmp, direction, to)))
+                    ((curItem2.passbl & direction) || PassableFromToTile(hero, cur, tmp, direction, to)))
                 {
                     curItem2.passbl |= direction;
 
@@ -389,14 +417,14 @@ bool Route::Path::Find(s32 to, int limit)
         }
 
 
-        pathPointsMap2.get(cur).open = 0;
+        cells->get(cur).open = 0;
 
-        it1_2 = pathPointsMap2._rows.begin();
+        it1_2 = cells->_rows.begin();
         alt = -1;
         tmp = MAXU16;
 
         // find minimal cost
-        it2_2 = pathPointsMap2._rows.end();
+        it2_2 = cells->_rows.end();
         for (; it1_2 != it2_2; ++it1_2)
             if ((*it1_2).Value.open)
             {
@@ -414,7 +442,7 @@ bool Route::Path::Find(s32 to, int limit)
         cur = alt;
 
         //if (0 < limit && GetCurrentLength(pathPointsMap, cur) > limit) break;
-        if (0 < limit && GetCurrentLength(pathPointsMap2, cur) > limit) break;
+        if (0 < limit && GetCurrentLength(*cells, cur) > limit) break;
     }
 
     // save path
@@ -422,10 +450,10 @@ bool Route::Path::Find(s32 to, int limit)
     {
         while (cur != from)
         {
-            auto &curItem2 = pathPointsMap2.get(cur);
-            push_front(Step(curItem2.parent, curItem2.direct, curItem2.cost_g));
+            auto &curItem2 = cells->get(cur);
+            path.push_front(Step(curItem2.parent, curItem2.direct, curItem2.cost_g));
             cur = curItem2.parent;
         }
     }
-    return !empty();
+    return !path.empty();
 }
@@ -362,7 +362,11 @@ uint32_t Kingdom::CountVisitedObjects(int object) const
 /* set visited cell */
 void Kingdom::SetVisited(s32 index, int object)
 {
-    if (!isVisited(index, object) && object != MP2::OBJ_ZERO) visit_object.push_front(IndexObject(index, object));
+    if (!isVisited(index, object) && object != MP2::OBJ_ZERO)
+    {
+        visit_object.push_front(IndexObject(index, object));
+        world.TileChanged(index);
+    }
 }
 
 bool Kingdom::HeroesMayStillMove() const
@@ -22,6 +22,7 @@
 
 #include <functional>
 #include <algorithm>
+#include <mutex>
 #include "agg.h"
 #include "artifact.h"
 #include "resource.h"
@@ -31,6 +32,7 @@
 #include "game.h"
 #include "game_over.h"
 #include "maps_actions.h"
+#include "battle_estimator.h"
 #include "world.h"
 #include "rand.h"
 #include <sstream>
@@ -208,6 +210,7 @@ void CapturedObjects::ResetColor(int color)
         {
             objcol.second = Color::UNUSED;
             world.GetTiles(it.first).CaptureFlags32(objcol.first, objcol.second);
+            world.TileChanged(it.first);
         }
     }
 }
@@ -256,6 +259,11 @@ void World::Reset()
 {
     // maps tiles
     vec_tiles.clear();
+    hot_tiles.Clear();
+    addons_pool.Clear();
+    objects_index.Clear();
+    positions_index.Reset(0, 0);
+    vec_regions.clear();
 
     // kingdoms
     vec_kingdoms.clear();
@@ -277,6 +285,8 @@ void World::Reset()
     map_actions.clear();
     map_objects.clear();
 
+    ResetChangedTiles();
+
     ultimate_artifact.Reset();
 
     day = 0;
@@ -288,6 +298,9 @@ void World::Reset()
 
     heroes_cond_wins = Heroes::UNKNOWN;
     heroes_cond_loss = Heroes::UNKNOWN;
+
+    // estimates keyed by castle index belong to the old map
+    Battle::Estimator::ClearCache();
 }
 
 /* new maps */
@@ -300,6 +313,8 @@ void World::NewMaps(uint32_t sw, uint32_t sh)
     Size::h = sh;
 
     vec_tiles.resize(w() * h());
+    hot_tiles.Resize(vec_tiles.size());
+    positions_index.Reset(w(), h());
 
     // init all tiles
     for (auto
@@ -378,14 +393,137 @@ const Kingdom &World::GetKingdom(int color) const
 }
 
 /* get castle from index maps */
+/* PositionsIndex */
+void PositionsIndex::Reset(int w, int h)
+{
+    width = w;
+    height = h;
+    heroes.assign(w * h, nullptr);
+    hero_counts.assign(w * h, 0);
+    castles.assign(w * h, nullptr);
+}
+
+void PositionsIndex::Rebuild(const AllHeroes &all_heroes, const AllCastles &all_castles)
+{
+    Reset(width, height);
+    validate = IS_DEBUG(DBG_GAME, DBG_TRACE);
+
+    for (Heroes *hero : all_heroes._items)
+        AddHero(*hero, TileIndex(hero->GetCenter()));
+
+    // the first castle wins, as in the linear scan
+    for (Castle *castle : all_castles)
+    {
+        const Point &center = castle->GetCenter();
+
+        for (s32 dy = -1; dy <= 0; ++dy)
+            for (s32 dx = -2; dx <= 2; ++dx)
+            {
+                const Point pt(center.x + dx, center.y + dy);
+                const s32 index = TileIndex(pt);
+
+                if (0 <= index && !castles[index] && castle->isPosition(pt))
+                    castles[index] = castle;
+            }
+    }
+}
+
+s32 PositionsIndex::TileIndex(const Point &pt) const
+{
+    return 0 <= pt.x && pt.x < width && 0 <= pt.y && pt.y < height ? pt.y * width + pt.x : -1;
+}
+
+void PositionsIndex::AddHero(Heroes &hero, s32 index)
+{
+    if (index < 0) return;
+
+    ++hero_counts[index];
+
+    if (!heroes[index] || hero.GetID() < heroes[index]->GetID())
+        heroes[index] = &hero;
+}
+
+void PositionsIndex::RemoveHero(const Heroes &hero, s32 index)
+{
+    if (index < 0 || !hero_counts[index]) return;
+
+    --hero_counts[index];
+
+    if (heroes[index] != &hero) return;
+
+    heroes[index] = nullptr;
+
+    // rare: another hero shares the tile
+    if (hero_counts[index])
+    {
+        const Point pt(index % width, index / width);
+
+        for (Heroes *other : world.vec_heroes._items)
+            if (other != &hero && other->isPosition(pt) &&
+                (!heroes[index] || other->GetID() < heroes[index]->GetID()))
+                heroes[index] = other;
+    }
+}
+
+void PositionsIndex::MoveHero(Heroes &hero, const Point &from)
+{
+    const s32 src = TileIndex(from);
+    const s32 dst = TileIndex(hero.GetCenter());
+
+    if (src == dst) return;
+
+    RemoveHero(hero, src);
+    AddHero(hero, dst);
+}
+
+Heroes *PositionsIndex::GetHero(const Point &pt) const
+{
+    const s32 index = TileIndex(pt);
+
+    if (index < 0) return world.vec_heroes.Get(pt);
+
+    if (validate)
+    {
+        Heroes *linear = world.vec_heroes.Get(pt);
+
+        if (linear != heroes[index])
+        {
+            ERROR("hero index differs at " << pt.x << ", " << pt.y);
+            return linear;
+        }
+    }
+
+    return heroes[index];
+}
+
+Castle *PositionsIndex::GetCastle(const Point &pt) const
+{
+    const s32 index = TileIndex(pt);
+
+    if (index < 0) return world.vec_castles.Get(pt);
+
+    if (validate)
+    {
+        Castle *linear = world.vec_castles.Get(pt);
+
+        if (linear != castles[index])
+        {
+            ERROR("castle index differs at " << pt.x << ", " << pt.y);
+            return linear;
+        }
+    }
+
+    return castles[index];
+}
+
 Castle *World::GetCastle(const Point &center)
 {
-    return vec_castles.Get(center);
+    return positions_index.GetCastle(center);
 }
 
 const Castle *World::GetCastle(const Point &center) const
 {
-    return vec_castles.Get(center);
+    return positions_index.GetCastle(center);
 }
 
 Heroes *World::GetHeroes(int id)
@@ -401,12 +539,12 @@ const Heroes *World::GetHeroes(int id) const
 /* get heroes from index maps */
 Heroes *World::GetHeroes(const Point &center)
 {
-    return vec_heroes.Get(center);
+    return positions_index.GetHero(center);
 }
 
 const Heroes *World::GetHeroes(const Point &center) const
 {
-    return vec_heroes.Get(center);
+    return positions_index.GetHero(center);
 }
 
 Heroes *World::GetFreemanHeroes(int race) const
@@ -508,6 +646,9 @@ void World::NewDay()
 
 void World::NewWeek()
 {
+    // the week objects and the gray towns change everywhere
+    ResetChangedTiles();
+
     // update week type
     week_current = week_next;
     const int type = LastWeek() ? Week::MonthRand() : Week::WeekRand();
@@ -518,11 +659,21 @@ void World::NewWeek()
 
     if (1 < week)
     {
-        // update week object
-        for (auto &vec_tile : vec_tiles)
-            if (MP2::isWeekLife(vec_tile.GetObject(false)) ||
-                MP2::OBJ_MONSTER == vec_tile.GetObject())
-                vec_tile.QuantityUpdate();
+        // update week object, in the map order as the updates draw random numbers
+        MapsIndexes weeklife = objects_index.Get(MP2::OBJ_MONSTER);
+
+        for (int obj = MP2::OBJ_ZERO + 1; obj < 0x100; ++obj)
+            if (MP2::OBJ_MONSTER != obj && MP2::isWeekLife(obj))
+                weeklife.insert(weeklife.end(), objects_index.Get(obj).begin(), objects_index.Get(obj).end());
+
+        for (s32 index : objects_index.Get(MP2::OBJ_HEROES))
+            if (MP2::isWeekLife(vec_tiles[index].GetObject(false)))
+                weeklife.push_back(index);
+
+        sort(weeklife.begin(), weeklife.end());
+
+        for (s32 index : weeklife)
+            vec_tiles[index].QuantityUpdate();
 
         // update gray towns
         for (auto &vec_castle : vec_castles)
@@ -544,6 +695,8 @@ void World::NewWeek()
 
 void World::NewMonth()
 {
+    ResetChangedTiles();
+
     // skip first month
     if (1 < week && week_current.GetType() == Week::MONSTERS && !Settings::Get().ExtWorldBanMonthOfMonsters())
         MonthOfMonstersAction(Monster(week_current.GetMonster()));
@@ -737,6 +890,8 @@ uint32_t World::CountCapturedMines(int type, int color) const
 /* capture object */
 void World::CaptureObject(s32 index, int color)
 {
+    TileChanged(index);
+
     int obj = GetTiles(index).GetObject(false);
     map_captureobj.Set(index, obj, color);
 
@@ -786,6 +941,31 @@ void World::ClearFog(int colors)
     map_captureobj.ClearFog(colors);
 }
 
+void World::TileChanged(s32 index)
+{
+    // more changes than tiles: a full scan is cheaper
+    if (changed_tiles.size() >= vec_tiles.size())
+        ResetChangedTiles();
+    else
+        changed_tiles.push_back(index);
+}
+
+const MapsIndexes &World::GetChangedTiles() const
+{
+    return changed_tiles;
+}
+
+uint32_t World::GetChangedEpoch() const
+{
+    return changed_epoch;
+}
+
+void World::ResetChangedTiles()
+{
+    changed_tiles.clear();
+    ++changed_epoch;
+}
+
 const UltimateArtifact &World::GetUltimateArtifact() const
 {
     return ultimate_artifact;
@@ -858,14 +1038,9 @@ string World::DateString() const
     return os.str();
 }
 
-bool IsObeliskOnMaps(const Maps::Tiles &tile)
-{
-    return MP2::OBJ_OBELISK == tile.GetObject(false);
-}
-
 uint32_t World::CountObeliskOnMaps()
 {
-    uint32_t res = count_if(vec_tiles.begin(), vec_tiles.end(), IsObeliskOnMaps);
+    uint32_t res = Maps::GetObjectPositions(MP2::OBJ_OBELISK, true).size();
     return res ? res : 6;
 }
 
@@ -1061,6 +1236,10 @@ int World::CheckKingdomLoss(const Kingdom &kingdom) const
 
 uint32_t World::GetUniq()
 {
+    // battles may run on simulator threads
+    static mutex uniq_mutex;
+    lock_guard<mutex> lock(uniq_mutex);
+
     return ++GameStatic::uniq;
 }
 ByteVectorWriter &operator<<(ByteVectorWriter &msg, const CapturedObject &obj)
@@ -1234,9 +1413,16 @@ ByteVectorReader &operator>>(ByteVectorReader &msg, World &w)
     Size &sz = w;
 
     msg >> sz;
+    w.hot_tiles.Resize(w.w() * w.h());
+    w.addons_pool.Clear();
+    w.positions_index.Reset(w.w(), w.h());
     msg >> w.vec_tiles;
+    Maps::Tiles::CompactAddons(w.vec_tiles);
+    w.objects_index.Rebuild(w.hot_tiles.objects);
+    w.ResetChangedTiles();
     msg >> w.vec_heroes;
     msg >> w.vec_castles;
+    w.positions_index.Rebuild(w.vec_heroes, w.vec_castles);
     msg >> w.vec_kingdoms;
     msg >> w.vec_rumors;
     msg >> w.vec_eventsday;
@@ -1254,6 +1440,12 @@ ByteVectorReader &operator>>(ByteVectorReader &msg, World &w)
     for_each(w.vec_tiles.begin(), w.vec_tiles.end(),
              mem_fun_ref(&Maps::Tiles::UpdatePassable));
 
+    // update monster protection
+    Maps::Tiles::UpdateMonsterGuards(w.vec_tiles);
+
+    // update land and water regions
+    w.ComputeRegions();
+
     // heroes postfix
     for_each(w.vec_heroes._items.begin(), w.vec_heroes._items.end(),
         [](Heroes* &hero) { hero->RescanPathPassable(); });
@@ -154,6 +154,38 @@ typedef vector<string> Rumors;
 typedef list<EventDate> EventsDate;
 typedef vector<Maps::Tiles> MapsTiles;
 
+/* heroes and castles by tile, for the lookups by position */
+class PositionsIndex
+{
+public:
+    PositionsIndex() : width(0), height(0), validate(false)
+    {}
+
+    void Reset(int w, int h);
+
+    void Rebuild(const AllHeroes &, const AllCastles &);
+
+    void MoveHero(Heroes &, const Point &from);
+
+    Heroes *GetHero(const Point &) const;
+
+    Castle *GetCastle(const Point &) const;
+
+private:
+    s32 TileIndex(const Point &) const;
+
+    void AddHero(Heroes &, s32);
+
+    void RemoveHero(const Heroes &, s32);
+
+    vector<Heroes *> heroes;  // the lowest hero id on the tile
+    vector<u8> hero_counts;
+    vector<Castle *> castles; // the castle covering the tile
+    int width;
+    int height;
+    bool validate;            // cross-check with the linear scans
+};
+
 class World : protected Size
 {
 public:
@@ -273,6 +305,16 @@ public:
 
     void ClearFog(int color);
 
+    /* a tile got a new object, owner, quantity, fog or visit; the AI updates its scans from the log */
+    void TileChanged(s32);
+
+    const MapsIndexes &GetChangedTiles() const;
+
+    /* changes since a new epoch, the log starts again after an overflow or a new week */
+    uint32_t GetChangedEpoch() const;
+
+    void ResetChangedTiles();
+
     void UpdateRecruits(Recruits &) const;
 
 
@@ -298,8 +340,14 @@ public:
 
     void PostFixLoad();
 
+    void ComputeRegions();
+
+    void UpdateRegions(s32);
+
+    bool isReachableRegion(s32 from, s32 to) const;
+
 private:
-    World() : Size(0, 0), day(0), week(0), month(0), heroes_cond_wins(0), heroes_cond_loss(0)
+    World() : Size(0, 0), day(0), week(0), month(0), heroes_cond_wins(0), heroes_cond_loss(0), changed_epoch(0)
     {};
 
     void Defaults();
@@ -310,6 +358,12 @@ private:
 
     void PostLoad();
 
+    s32 GetRegion(s32) const;
+
+    void MergeRegions(s32, s32);
+
+    void FlattenRegions();
+
 private:
     friend class Radar;
 
@@ -318,6 +372,14 @@ private:
     friend ByteVectorReader &operator>>(ByteVectorReader &, World &);
 public:
     MapsTiles vec_tiles;
+    Maps::TilesHot hot_tiles;
+    Maps::AddonsPool addons_pool;
+
+    // tiles by object, not saved
+    Maps::ObjectsIndex objects_index;
+
+    // heroes and castles by tile, not saved
+    PositionsIndex positions_index;
     AllHeroes vec_heroes;
     AllCastles vec_castles;
     Kingdoms vec_kingdoms;
@@ -341,6 +403,13 @@ public:
 
     MapActions map_actions;
     MapObjects map_objects;
+
+    // connected land and water regions, not saved
+    vector<s32> vec_regions;
+
+    // changed tiles for the AI scans, not saved
+    MapsIndexes changed_tiles;
+    uint32_t changed_epoch;
 };
 
 ByteVectorWriter &operator<<(ByteVectorWriter &, const CapturedObject &);
@@ -145,6 +145,8 @@ bool World::LoadMapMP2(const string &filename)
     fs.seek(MP2OFFSETDATA);
 
     vec_tiles.resize(w() * h());
+    hot_tiles.Resize(vec_tiles.size());
+    positions_index.Reset(w(), h());
 
     // read all tiles
     for (auto it = vec_tiles.begin(); it != vec_tiles.end(); ++it)
@@ -263,6 +265,9 @@ bool World::LoadMapMP2(const string &filename)
         map_captureobj.Set(Maps::GetIndexFromAbsPoint(cx, cy), MP2::OBJ_CASTLE, Color::NONE);
     }
 
+    // the castles do not move, the heroes update the index as they move
+    positions_index.Rebuild(vec_heroes, vec_castles);
+
     fs.seek(endof_addons + (72 * 3));
 
     // cood resource kingdoms
@@ -669,6 +674,15 @@ void World::PostLoad()
         tile.UpdatePassable();
     });
 
+    // update monster protection
+    Maps::Tiles::UpdateMonsterGuards(vec_tiles);
+
+    // one contiguous addons pool in the tile order
+    Maps::Tiles::CompactAddons(vec_tiles);
+
+    // update land and water regions
+    ComputeRegions();
+
     // play with hero
     vec_kingdoms.ApplyPlayWithStartingHero();
 
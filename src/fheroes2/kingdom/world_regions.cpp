@@ -0,0 +1,127 @@
+/***************************************************************************
+ *   Copyright (C) 2009 by Andrey Afletdinov <fheroes2@gmail.com>          *
+ *                                                                         *
+ *   Part of the Free Heroes2 Engine:                                      *
+ *   http://sourceforge.net/projects/fheroes2                              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include <numeric>
+#include "world.h"
+#include "maps.h"
+#include "direction.h"
+
+namespace
+{
+    /* the same passable test as the pathfinder: out of the first tile and into the second one */
+    bool IsRegionEdge(const Maps::Tiles &tile1, const Maps::Tiles &tile2, int direct)
+    {
+        return tile1.isWater() == tile2.isWater() &&
+               (tile1.GetPassable() & direct) &&
+               (tile2.GetPassable() & Direction::Reflect(direct));
+    }
+}
+
+/* lookups never write, so path queries may run concurrently */
+s32 World::GetRegion(s32 index) const
+{
+    while (vec_regions[index] != index)
+        index = vec_regions[index];
+    return index;
+}
+
+void World::MergeRegions(s32 index1, s32 index2)
+{
+    const s32 region1 = GetRegion(index1);
+    const s32 region2 = GetRegion(index2);
+
+    // parent index is always less than child index
+    if (region1 != region2)
+        vec_regions[max(region1, region2)] = min(region1, region2);
+}
+
+void World::FlattenRegions()
+{
+    for (auto &region : vec_regions)
+        region = vec_regions[region];
+}
+
+void World::ComputeRegions()
+{
+    vec_regions.resize(vec_tiles.size());
+    iota(vec_regions.begin(), vec_regions.end(), 0);
+
+    const int directions[] = {Direction::RIGHT, Direction::BOTTOM_RIGHT, Direction::BOTTOM, Direction::BOTTOM_LEFT};
+    const Size wSize(w(), h());
+
+    for (s32 index = 0; index < static_cast<s32>(vec_tiles.size()); ++index)
+    {
+        for (int direct : directions)
+        {
+            if (!Maps::isValidDirection(index, direct, wSize))
+                continue;
+
+            const s32 next = Maps::GetDirectionIndex(index, direct);
+            if (IsRegionEdge(vec_tiles[index], vec_tiles[next], direct))
+                MergeRegions(index, next);
+        }
+    }
+
+    FlattenRegions();
+}
+
+void World::UpdateRegions(s32 index)
+{
+    if (vec_regions.size() != vec_tiles.size() || !Maps::isValidAbsIndex(index))
+        return;
+
+    const Size wSize(w(), h());
+
+    for (int direct : Direction::All())
+    {
+        if (!Maps::isValidDirection(index, direct, wSize))
+            continue;
+
+        const s32 next = Maps::GetDirectionIndex(index, direct);
+        if (IsRegionEdge(vec_tiles[index], vec_tiles[next], direct))
+            MergeRegions(index, next);
+    }
+
+    FlattenRegions();
+}
+
+bool World::isReachableRegion(s32 from, s32 to) const
+{
+    if (vec_regions.size() != vec_tiles.size() ||
+        !Maps::isValidAbsIndex(from) || !Maps::isValidAbsIndex(to))
+        return true;
+
+    const s32 region = GetRegion(from);
+
+    if (region == GetRegion(to))
+        return true;
+
+    // the last step may cross the coast: boat, coast or hero on the other side
+    const Size wSize(w(), h());
+
+    for (int direct : Direction::All())
+        if (Maps::isValidDirection(to, direct, wSize) &&
+            region == GetRegion(Maps::GetDirectionIndex(to, direct)))
+            return true;
+
+    return false;
+}
@@ -354,8 +354,18 @@ Maps::Indexes Maps::ScanAroundObjects(s32 center, uint32_t dist, const u8 *objs)
 
 Maps::Indexes Maps::GetObjectPositions(int obj, bool check_hero)
 {
-    Indexes results = GetAllIndexes();
-    MapsIndexesFilteredObject(results, obj);
+    Indexes results;
+
+    if (MP2::OBJ_ZERO == obj)
+    {
+        // the empty tiles are not indexed
+        const vector<u8> &objects = world.hot_tiles.objects;
+
+        for (size_t it = 0; it < objects.size(); ++it)
+            if (obj == objects[it])
+                results.push_back(it);
+    } else
+        results = world.objects_index.Get(obj);
 
     if (check_hero && obj != MP2::OBJ_HEROES)
     {
@@ -380,8 +390,19 @@ Maps::Indexes Maps::GetObjectPositions(s32 center, int obj, bool check_hero)
 
 Maps::Indexes Maps::GetObjectsPositions(const u8 *objs)
 {
-    Indexes results = GetAllIndexes();
-    return MapsIndexesFilteredObjects(results, objs);
+    Indexes results;
+
+    while (objs && *objs)
+    {
+        const Indexes &positions = world.objects_index.Get(*objs);
+        results.insert(results.end(), positions.begin(), positions.end());
+        ++objs;
+    }
+
+    // in the map order, an object listed twice only once
+    sort(results.begin(), results.end());
+    results.erase(unique(results.begin(), results.end()), results.end());
+    return results;
 }
 
 bool MapsTileIsUnderProtection(s32 from, s32 index) /* from: center, index: monster */
@@ -421,35 +442,47 @@ bool Maps::IsNearTiles(s32 index1, s32 index2)
 
 bool Maps::TileIsUnderProtection(s32 center)
 {
-    return MP2::OBJ_MONSTER == world.GetTiles(center).GetObject() || !GetTilesUnderProtection(center).empty();
-}
+    const Tiles &tile = world.GetTiles(center);
 
-namespace
-{
-    Maps::Indexes tilesIndexesUnderProtection;
+    if (MP2::OBJ_MONSTER == tile.GetObject())
+        return true;
+
+    const int guards = tile.GetMonsterGuards();
+
+    if (guards)
+    {
+        for (int direction : Direction::All())
+            if ((guards & direction) &&
+                MapsTileIsUnderProtection(GetDirectionIndex(center, direction), center))
+                return true;
+    }
+
+    return false;
 }
 
 Maps::Indexes Maps::GetTilesUnderProtection(s32 center)
 {
+    Indexes result;
+    const Tiles &tile = world.GetTiles(center);
+    const int guards = tile.GetMonsterGuards();
 
-    ScanAroundObject(center, MP2::OBJ_MONSTER, tilesIndexesUnderProtection);
-
-    if (!tilesIndexesUnderProtection.empty())
+    if (guards)
     {
-        auto removeIt = remove_if(
-                tilesIndexesUnderProtection.begin(), tilesIndexesUnderProtection.end(),
-                [&](auto &it) {
-                    return !MapsTileIsUnderProtection(it, center);
-                });
-        int distVal = distance(tilesIndexesUnderProtection.begin(),
-                               removeIt);
-        tilesIndexesUnderProtection.resize(distVal);
+        for (int direction : Direction::All())
+        {
+            if (!(guards & direction))
+                continue;
+
+            const s32 index = GetDirectionIndex(center, direction);
+            if (MapsTileIsUnderProtection(index, center))
+                result.push_back(index);
+        }
     }
 
-    if (MP2::OBJ_MONSTER == world.GetTiles(center).GetObject())
-        tilesIndexesUnderProtection.push_back(center);
+    if (MP2::OBJ_MONSTER == tile.GetObject())
+        result.push_back(center);
 
-    return tilesIndexesUnderProtection;
+    return result;
 }
 
 uint32_t Maps::GetApproximateDistance(s32 index1, s32 index2)
@@ -1018,15 +1018,68 @@ bool Maps::TilesAddon::ForceLevel2(const TilesAddon &ta)
 }
 
 /* Maps::Addons */
-void Maps::Addons::Remove(uint32_t uniq)
+Maps::Addons::iterator Maps::Addons::begin()
+{
+    return world.addons_pool.items.data() + offset;
+}
+
+Maps::Addons::const_iterator Maps::Addons::begin() const
+{
+    return world.addons_pool.items.data() + offset;
+}
+
+void Maps::Addons::push_back(const TilesAddon &ta)
 {
-    Addons clean;
-    for (auto &addon : *this)
+    // the argument may live in the pool
+    TilesAddon addon;
+    addon = ta;
+    AddonsPool &pool = world.addons_pool;
+
+    if (count == capacity)
     {
-        if (!addon.isUniq(uniq))
-            clean.push_back(addon);
+        const uint32_t grow = max<uint32_t>(2, capacity);
+        const uint32_t last = pool.items.size();
+
+        if (offset + capacity == last)
+            // the last range grows in place
+            pool.items.resize(last + grow);
+        else
+        {
+            pool.items.resize(last + capacity + grow);
+            copy(pool.items.begin() + offset, pool.items.begin() + offset + count, pool.items.begin() + last);
+            pool.unused += capacity;
+            offset = last;
+        }
+
+        capacity += grow;
     }
-    *this = clean;
+
+    pool.items[offset + count] = addon;
+    ++count;
+}
+
+void Maps::Addons::Remove(uint32_t uniq)
+{
+    count = distance(begin(), remove_if(begin(), end(), [uniq](const TilesAddon &addon)
+    {
+        return addon.isUniq(uniq);
+    }));
+}
+
+void Maps::Addons::Compact(vector<TilesAddon> &pool)
+{
+    const uint32_t last = pool.size();
+
+    pool.insert(pool.end(), begin(), end());
+    offset = last;
+    capacity = count;
+}
+
+/* Maps::AddonsPool */
+void Maps::AddonsPool::Clear()
+{
+    items.clear();
+    unused = 0;
 }
 
 uint32_t PackTileSpriteIndex(uint32_t index, uint32_t shape) /* index max: 0x3FFF, shape value: 0, 1, 2, 3 */
@@ -1035,25 +1088,135 @@ uint32_t PackTileSpriteIndex(uint32_t index, uint32_t shape) /* index max: 0x3FF
 }
 
 /* Maps::Tiles */
-Maps::Tiles::Tiles() : maps_index(0), pack_sprite_index(0), tile_passable(DIRECTION_ALL),
-                       mp2_object(0), fog_colors(Color::ALL), quantity1(0), quantity2(0), quantity3(0)
+/* Maps::TilesHot */
+void Maps::TilesHot::Resize(size_t size)
+{
+    objects.assign(size, MP2::OBJ_ZERO);
+    passables.assign(size, DIRECTION_ALL);
+    fogs.assign(size, Color::ALL);
+    grounds.assign(size, Ground::WATER);
+    roads.assign(size, 0);
+}
+
+void Maps::TilesHot::Clear()
+{
+    objects.clear();
+    passables.clear();
+    fogs.clear();
+    grounds.clear();
+    roads.clear();
+}
+
+/* Maps::ObjectsIndex */
+void Maps::ObjectsIndex::Clear()
+{
+    for (auto &it : positions)
+        it.clear();
+}
+
+void Maps::ObjectsIndex::Rebuild(const vector<u8> &objects)
+{
+    Clear();
+
+    for (size_t it = 0; it < objects.size(); ++it)
+        if (MP2::OBJ_ZERO != objects[it])
+            positions[objects[it]].push_back(it);
+}
+
+void Maps::ObjectsIndex::Move(s32 index, int from, int to)
+{
+    if (MP2::OBJ_ZERO != from)
+    {
+        MapsIndexes &v = positions[from & 0xFF];
+        auto it = lower_bound(v.begin(), v.end(), index);
+        if (it != v.end() && *it == index) v.erase(it);
+    }
+
+    if (MP2::OBJ_ZERO != to)
+    {
+        MapsIndexes &v = positions[to & 0xFF];
+        v.insert(lower_bound(v.begin(), v.end(), index), index);
+    }
+}
+
+int GroundFromSprite(uint32_t index)
+{
+    // list grounds from GROUND32.TIL
+    if (30 > index)
+        return Maps::Ground::WATER;
+    if (92 > index)
+        return Maps::Ground::GRASS;
+    if (146 > index)
+        return Maps::Ground::SNOW;
+    if (208 > index)
+        return Maps::Ground::SWAMP;
+    if (262 > index)
+        return Maps::Ground::LAVA;
+    if (321 > index)
+        return Maps::Ground::DESERT;
+    if (361 > index)
+        return Maps::Ground::DIRT;
+    if (415 > index)
+        return Maps::Ground::WASTELAND;
+
+    //else if(432 > pack_sprite_index)
+
+    return Maps::Ground::BEACH;
+}
+
+/* Maps::Tiles */
+Maps::Tiles::Tiles() : maps_index(0), pack_sprite_index(0), quantity1(0), quantity2(0), quantity3(0),
+                       monster_guards(0)
+{
+}
+
+u8 &Maps::Tiles::HotObject()
+{
+    return world.hot_tiles.objects[maps_index];
+}
+
+u8 Maps::Tiles::HotObject() const
+{
+    return world.hot_tiles.objects[maps_index];
+}
+
+u16 &Maps::Tiles::HotPassable()
+{
+    return world.hot_tiles.passables[maps_index];
+}
+
+u16 Maps::Tiles::HotPassable() const
+{
+    return world.hot_tiles.passables[maps_index];
+}
+
+u8 &Maps::Tiles::HotFogs()
 {
+    return world.hot_tiles.fogs[maps_index];
+}
+
+u8 Maps::Tiles::HotFogs() const
+{
+    return world.hot_tiles.fogs[maps_index];
 }
 
 void Maps::Tiles::Init(s32 index, const MP2::mp2tile_t &mp2)
 {
-    tile_passable = DIRECTION_ALL;
+    // the hot fields live at the tile index
+    SetIndex(index);
+
+    HotPassable() = DIRECTION_ALL;
     quantity1 = mp2.quantity1;
     quantity2 = mp2.quantity2;
     quantity3 = 0;
-    fog_colors = Color::ALL;
+    HotFogs() = Color::ALL;
 
     SetTile(mp2.tileIndex, mp2.shape);
-    SetIndex(index);
     SetObject(mp2.generalObject);
 
-    addons_level1.clear();
-    addons_level2.clear();
+    // fresh ranges, the pool was cleared with the world
+    addons_level1 = Addons();
+    addons_level2 = Addons();
 
     AddonsPushLevel1(mp2);
     AddonsPushLevel2(mp2);
@@ -1076,7 +1239,7 @@ void Maps::Tiles::SetQuantity3(int mod)
 
 Heroes *Maps::Tiles::GetHeroes() const
 {
-    return MP2::OBJ_HEROES == mp2_object && GetQuantity3() ?
+    return MP2::OBJ_HEROES == HotObject() && GetQuantity3() ?
            world.GetHeroes(GetQuantity3() - 1) : nullptr;
 }
 
@@ -1084,7 +1247,7 @@ void Maps::Tiles::SetHeroes(Heroes *hero)
 {
     if (hero)
     {
-        hero->SetMapsObject(mp2_object);
+        hero->SetMapsObject(HotObject());
         SetQuantity3(hero->GetID() + 1);
         SetObject(MP2::OBJ_HEROES);
     } else
@@ -1114,23 +1277,88 @@ s32 Maps::Tiles::GetIndex() const
 
 int Maps::Tiles::GetObject(bool skip_hero  /* true */) const
 {
-    if (!skip_hero && MP2::OBJ_HEROES == mp2_object)
+    if (!skip_hero && MP2::OBJ_HEROES == HotObject())
     {
         const Heroes *hero = GetHeroes();
         return hero ? hero->GetMapsObject() : MP2::OBJ_ZERO;
     }
 
-    return mp2_object;
+    return HotObject();
 }
 
 void Maps::Tiles::SetObject(int object)
 {
-    mp2_object = object;
+    const bool monster = MP2::OBJ_MONSTER == object;
+    const bool changed = monster != (MP2::OBJ_MONSTER == HotObject());
+
+    if (HotObject() != object)
+    {
+        world.TileChanged(GetIndex());
+        world.objects_index.Move(GetIndex(), HotObject(), object);
+    }
+
+    HotObject() = object;
+
+    if (changed) SetMonsterGuard(monster);
+}
+
+/* mark or unmark this tile as a guard for all neighbours */
+void Maps::Tiles::SetMonsterGuard(bool monster)
+{
+    const s32 center = GetIndex();
+    Size wSize(world.w(), world.h());
+
+    if (world.vec_tiles.size() != static_cast<size_t>(wSize.w * wSize.h))
+        return;
+
+    for (int direction : Direction::All())
+    {
+        if (!isValidDirection(center, direction, wSize))
+            continue;
+
+        Tiles &tile = world.GetTiles(GetDirectionIndex(center, direction));
+
+        if (monster)
+            tile.monster_guards |= Direction::Reflect(direction);
+        else
+            tile.monster_guards &= ~Direction::Reflect(direction);
+    }
+}
+
+void Maps::Tiles::UpdateMonsterGuards(vector<Tiles> &tiles)
+{
+    for (auto &tile : tiles)
+        tile.monster_guards = 0;
+
+    for (auto &tile : tiles)
+        if (MP2::OBJ_MONSTER == tile.HotObject())
+            tile.SetMonsterGuard(true);
+}
+
+void Maps::Tiles::CompactAddons(vector<Tiles> &tiles)
+{
+    AddonsPool &pool = world.addons_pool;
+    vector<TilesAddon> items;
+
+    items.reserve(pool.items.size() - pool.unused);
+
+    // tile order, the level 1 before the level 2
+    for (auto &tile : tiles)
+    {
+        tile.addons_level1.Compact(items);
+        tile.addons_level2.Compact(items);
+    }
+
+    VERBOSE("addons: " << items.size() << ", pool slots: " << pool.items.size() << " -> " << items.size());
+
+    pool.items.swap(items);
+    pool.unused = 0;
 }
 
 void Maps::Tiles::SetTile(uint32_t sprite_index, uint32_t shape)
 {
     pack_sprite_index = PackTileSpriteIndex(sprite_index, shape);
+    world.hot_tiles.grounds[maps_index] = GroundFromSprite(TileSpriteIndex());
 }
 
 uint32_t Maps::Tiles::TileSpriteIndex() const
@@ -1196,20 +1424,22 @@ bool Maps::Tiles::isLongObject(int direction)
 
 void Maps::Tiles::UpdatePassable()
 {
-    tile_passable = DIRECTION_ALL;
+    UpdateRoads();
+
+    HotPassable() = DIRECTION_ALL;
 
     const int obj = GetObject(false);
     bool emptyobj = MP2::OBJ_ZERO == obj || MP2::OBJ_COAST == obj || MP2::OBJ_EVENT == obj;
 
     if (MP2::isActionObject(obj, isWater()))
     {
-        tile_passable = MP2::GetObjectDirect(obj);
+        HotPassable() = MP2::GetObjectDirect(obj);
         return;
     }
 
     Size wSize(world.w(), world.h());
     // on ground
-    if (MP2::OBJ_HEROES != mp2_object && !isWater())
+    if (MP2::OBJ_HEROES != HotObject() && !isWater())
     {
         bool mounts1 = addons_level1.end() != find_if(addons_level1.begin(), addons_level1.end(), isMountsRocs);
         bool mounts2 = addons_level2.end() != find_if(addons_level2.begin(), addons_level2.end(), isMountsRocs);
@@ -1217,37 +1447,37 @@ void Maps::Tiles::UpdatePassable()
         bool trees2 = addons_level2.end() != find_if(addons_level2.begin(), addons_level2.end(), isForestsTrees);
 
         // fix coast passable
-        if (tile_passable &&
+        if (HotPassable() &&
             //! MP2::isActionObject(obj, false) &&
             !emptyobj &&
             TileIsCoast(GetIndex(), Direction::TOP | Direction::BOTTOM | Direction::LEFT | Direction::RIGHT) &&
             (addons_level1.size() != static_cast<size_t>(count_if(addons_level1.begin(), addons_level1.end(),
                                                                   ptr_fun(&TilesAddon::isShadow)))))
         {
-            tile_passable = 0;
+            HotPassable() = 0;
         }
 
         // fix mountain layer
-        if (tile_passable &&
+        if (HotPassable() &&
             (MP2::OBJ_MOUNTS == obj || MP2::OBJ_TREES == obj) &&
             mounts1 && (mounts2 || trees2))
         {
-            tile_passable = 0;
+            HotPassable() = 0;
         }
 
         // fix trees layer
-        if (tile_passable &&
+        if (HotPassable() &&
             (MP2::OBJ_MOUNTS == obj || MP2::OBJ_TREES == obj) &&
             trees1 && (mounts2 || trees2))
         {
-            tile_passable = 0;
+            HotPassable() = 0;
         }
 
         // town twba
-        if (tile_passable &&
+        if (HotPassable() &&
             FindAddonICN1(ICN::OBJNTWBA) && (mounts2 || trees2))
         {
-            tile_passable = 0;
+            HotPassable() = 0;
         }
 
         if (isValidDirection(GetIndex(), Direction::TOP, wSize))
@@ -1255,30 +1485,30 @@ void Maps::Tiles::UpdatePassable()
             Tiles &top = world.GetTiles(GetDirectionIndex(GetIndex(), Direction::TOP));
             // fix: rocs on water
             if (top.isWater() &&
-                top.tile_passable &&
-                !(Direction::TOP & top.tile_passable))
+                top.HotPassable() &&
+                !(Direction::TOP & top.HotPassable()))
             {
-                top.tile_passable = 0;
+                top.HotPassable() = 0;
             }
         }
     }
 
     // fix bottom border: disable passable for all no action objects
-    if (tile_passable &&
+    if (HotPassable() &&
         !isValidDirection(GetIndex(), Direction::BOTTOM, wSize) &&
         !emptyobj &&
         !MP2::isActionObject(obj, isWater()))
     {
-        tile_passable = 0;
+        HotPassable() = 0;
     }
 
     // check all sprite (level 1)
     for (Addons::const_iterator
                  it = addons_level1.begin(); it != addons_level1.end(); ++it)
     {
-        if (tile_passable)
+        if (HotPassable())
         {
-            tile_passable &= TilesAddon::GetPassable(*it);
+            HotPassable() &= TilesAddon::GetPassable(*it);
         }
     }
 
@@ -1291,10 +1521,10 @@ void Maps::Tiles::UpdatePassable()
             top.addons_level1.end() !=
             find_if(top.addons_level1.begin(), top.addons_level1.end(), TopObjectDisable) &&
             !MP2::isActionObject(top.GetObject(false), isWater()) &&
-            (tile_passable && !(tile_passable & DIRECTION_TOP_ROW)) &&
-            !(top.tile_passable & DIRECTION_TOP_ROW))
+            (HotPassable() && !(HotPassable() & DIRECTION_TOP_ROW)) &&
+            !(top.HotPassable() & DIRECTION_TOP_ROW))
         {
-            top.tile_passable = 0;
+            top.HotPassable() = 0;
         }
     }
 
@@ -1304,20 +1534,20 @@ void Maps::Tiles::UpdatePassable()
         Tiles &left = world.GetTiles(GetDirectionIndex(GetIndex(), Direction::LEFT));
 
         // left corner
-        if (left.tile_passable &&
+        if (left.HotPassable() &&
             isLongObject(Direction::TOP) &&
-            !((Direction::TOP | Direction::TOP_LEFT) & tile_passable) &&
-            (Direction::TOP_RIGHT & left.tile_passable))
+            !((Direction::TOP | Direction::TOP_LEFT) & HotPassable()) &&
+            (Direction::TOP_RIGHT & left.HotPassable()))
         {
-            left.tile_passable &= ~Direction::TOP_RIGHT;
+            left.HotPassable() &= ~Direction::TOP_RIGHT;
         } else
             // right corner
-        if (tile_passable &&
+        if (HotPassable() &&
             left.isLongObject(Direction::TOP) &&
-            !((Direction::TOP | Direction::TOP_RIGHT) & left.tile_passable) &&
-            (Direction::TOP_LEFT & tile_passable))
+            !((Direction::TOP | Direction::TOP_RIGHT) & left.HotPassable()) &&
+            (Direction::TOP_LEFT & HotPassable()))
         {
-            tile_passable &= ~Direction::TOP_LEFT;
+            HotPassable() &= ~Direction::TOP_LEFT;
         }
     }
 }
@@ -1330,7 +1560,7 @@ uint32_t Maps::Tiles::GetObjectUID(int obj) const
 
 int Maps::Tiles::GetPassable() const
 {
-    return tile_passable;
+    return HotPassable();
 }
 
 void Maps::Tiles::AddonsPushLevel1(const MP2::mp2tile_t &mt)
@@ -1383,34 +1613,12 @@ void Maps::Tiles::AddonsSort()
 
 int Maps::Tiles::GetGround() const
 {
-    const uint32_t index = TileSpriteIndex();
-
-    // list grounds from GROUND32.TIL
-    if (30 > index)
-        return Ground::WATER;
-    if (92 > index)
-        return Ground::GRASS;
-    if (146 > index)
-        return Ground::SNOW;
-    if (208 > index)
-        return Ground::SWAMP;
-    if (262 > index)
-        return Ground::LAVA;
-    if (321 > index)
-        return Ground::DESERT;
-    if (361 > index)
-        return Ground::DIRT;
-    if (415 > index)
-        return Ground::WASTELAND;
-
-    //else if(432 > pack_sprite_index)
-
-    return Ground::BEACH;
+    return world.hot_tiles.grounds[maps_index];
 }
 
 bool Maps::Tiles::isWater() const
 {
-    return 30 > TileSpriteIndex();
+    return Ground::WATER == world.hot_tiles.grounds[maps_index];
 }
 
 void Maps::Tiles::Remove(uint32_t uniq)
@@ -1501,7 +1709,7 @@ void Maps::Tiles::RedrawMonster(Surface &dst) const
         const Tiles &tile = world.GetTiles(it);
         dst_index = it;
 
-        if (MP2::OBJ_HEROES != mp2_object ||
+        if (MP2::OBJ_HEROES != HotObject() ||
             // skip bottom, bottom_right, bottom_left with ground objects
             ((DIRECTION_BOTTOM_ROW & Direction::Get(GetIndex(), it)) &&
              MP2::isGroundObject(tile.GetObject(false))) ||
@@ -1608,7 +1816,7 @@ void Maps::Tiles::RedrawBottom4Hero(Surface &dst) const
         return;
     for (const auto &it : addons_level1)
     {
-        if (SkipRedrawTileBottom4Hero(it, tile_passable))
+        if (SkipRedrawTileBottom4Hero(it, HotPassable()))
             continue;
         const u8 &object = it.object;
         const u8 &index = it.index;
@@ -1758,7 +1966,7 @@ string Maps::Tiles::String() const
         os << ")";
     }
     os << endl <<
-       "passable        : " << (tile_passable ? Direction::String(tile_passable) : "false");
+       "passable        : " << (HotPassable() ? Direction::String(HotPassable()) : "false");
     os <<
        endl <<
        "mp2 object      : " << "0x" << setw(2) << setfill('0') << GetObject() <<
@@ -1852,7 +2060,7 @@ string Maps::Tiles::String() const
 
 void Maps::Tiles::FixObject()
 {
-    if (MP2::OBJ_ZERO != mp2_object)
+    if (MP2::OBJ_ZERO != HotObject())
         return;
     if (addons_level1.end() != find_if(addons_level1.begin(), addons_level1.end(), TilesAddon::isArtifact))
         SetObject(MP2::OBJ_ARTIFACT);
@@ -1920,7 +2128,7 @@ bool Maps::Tiles::isPassable(const Heroes *hero, int direct, bool skipfog) const
     if (!skipfog && isFog(Settings::Get().CurrentColor()))
         return false;
 
-    return !(hero && !isPassable(*hero)) && direct & tile_passable;
+    return !(hero && !isPassable(*hero)) && direct & HotPassable();
 
 }
 
@@ -1930,9 +2138,11 @@ void Maps::Tiles::SetObjectPassable(bool pass)
     {
         case MP2::OBJ_TROLLBRIDGE:
             if (pass)
-                tile_passable |= Direction::TOP_LEFT;
-            else
-                tile_passable &= ~Direction::TOP_LEFT;
+            {
+                HotPassable() |= Direction::TOP_LEFT;
+                world.UpdateRegions(GetIndex());
+            } else
+                HotPassable() &= ~Direction::TOP_LEFT;
             break;
 
         default:
@@ -1943,12 +2153,24 @@ void Maps::Tiles::SetObjectPassable(bool pass)
 /* check road */
 bool Maps::Tiles::isRoad(int direct) const
 {
+    return direct & world.hot_tiles.roads[maps_index];
+}
+
+void Maps::Tiles::UpdateRoads()
+{
+    int roads = 0;
+
     for (const auto &addon: addons_level1)
-    {
-        if (addon.isRoad(direct))
-            return true;
-    }
-    return false;
+        for (int direct = Direction::TOP_LEFT; direct <= Direction::CENTER; direct <<= 1)
+            if (addon.isRoad(direct))
+                roads |= direct;
+
+    world.hot_tiles.roads[maps_index] = roads;
+}
+
+bool Maps::Tiles::isObject(int obj) const
+{
+    return obj == HotObject();
 }
 
 bool Maps::Tiles::isStream() const
@@ -2318,11 +2540,13 @@ void Maps::Tiles::RemoveObjectSprite()
 
         case MP2::OBJ_JAIL:
             RemoveJailSprite();
-            tile_passable = DIRECTION_ALL;
+            HotPassable() = DIRECTION_ALL;
+            world.UpdateRegions(GetIndex());
             break;
         case MP2::OBJ_BARRIER:
             RemoveBarrierSprite();
-            tile_passable = DIRECTION_ALL;
+            HotPassable() = DIRECTION_ALL;
+            world.UpdateRegions(GetIndex());
             break;
 
         default:
@@ -2534,12 +2758,14 @@ void Maps::Tiles::UpdateTreasureChestSprite(Tiles &tile)
 bool Maps::Tiles::isFog(int colors) const
 {
     // colors may be the union friends
-    return (fog_colors & colors) == colors;
+    return (HotFogs() & colors) == colors;
 }
 
 void Maps::Tiles::ClearFog(int colors)
 {
-    fog_colors &= ~colors;
+    if (HotFogs() & colors) world.TileChanged(GetIndex());
+
+    HotFogs() &= ~colors;
 }
 
 void Maps::Tiles::RedrawFogs(Surface &dst, int color) const
@@ -2852,14 +3078,37 @@ ByteVectorReader &Maps::operator>>(ByteVectorReader &msg, TilesAddon &ta)
     return msg >> ta.object >> ta.index >> ta.tmp;
 }
 
+ByteVectorWriter &Maps::operator<<(ByteVectorWriter &msg, const Addons &addons)
+{
+    msg.put32(addons.size());
+    for (const auto &addon : addons)
+        msg << addon;
+    return msg;
+}
+
+ByteVectorReader &Maps::operator>>(ByteVectorReader &msg, Addons &addons)
+{
+    const uint32_t size = msg.get32();
+
+    // a fresh range, the pool was cleared before the load
+    addons = Addons();
+    for (uint32_t ii = 0; ii < size; ++ii)
+    {
+        TilesAddon addon;
+        msg >> addon;
+        addons.push_back(addon);
+    }
+    return msg;
+}
+
 ByteVectorWriter &Maps::operator<<(ByteVectorWriter &msg, const Tiles &tile)
 {
     return msg <<
         tile.maps_index <<
         tile.pack_sprite_index <<
-        tile.tile_passable <<
-        tile.mp2_object <<
-        tile.fog_colors <<
+        tile.HotPassable() <<
+        tile.HotObject() <<
+        tile.HotFogs() <<
         tile.quantity1 <<
         tile.quantity2 <<
         tile.quantity3 <<
@@ -2869,12 +3118,15 @@ ByteVectorWriter &Maps::operator<<(ByteVectorWriter &msg, const Tiles &tile)
 
 ByteVectorReader &Maps::operator>>(ByteVectorReader &msg, Tiles &tile)
 {
+    // the index first, it places the hot fields
+    msg >> tile.maps_index;
+    msg >> tile.pack_sprite_index;
+    tile.SetTile(tile.TileSpriteIndex(), tile.TileSpriteShape());
+
     return msg >>
-               tile.maps_index >>
-               tile.pack_sprite_index >>
-               tile.tile_passable >>
-               tile.mp2_object >>
-               tile.fog_colors >>
+               tile.HotPassable() >>
+               tile.HotObject() >>
+               tile.HotFogs() >>
                tile.quantity1 >>
                tile.quantity2 >>
                tile.quantity3 >>
@@ -24,8 +24,10 @@
 
 
 #include <list>
+#include <iterator>
 #include "gamedefs.h"
 #include "direction.h"
+#include "maps.h"
 #include "serialize.h"
 #include "skill.h"
 #include "artifact.h"
@@ -189,9 +191,101 @@ namespace Maps
         u8 tmp;
     };
 
-    struct Addons : vector<TilesAddon>
+    /* the addons of one tile level, a range of World::addons_pool */
+    class Addons
     {
+    public:
+        typedef TilesAddon *iterator;
+        typedef const TilesAddon *const_iterator;
+        typedef std::reverse_iterator<iterator> reverse_iterator;
+        typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+
+        Addons() : offset(0), count(0), capacity(0)
+        {}
+
+        iterator begin();
+
+        iterator end()
+        { return begin() + count; }
+
+        const_iterator begin() const;
+
+        const_iterator end() const
+        { return begin() + count; }
+
+        reverse_iterator rbegin()
+        { return reverse_iterator(end()); }
+
+        reverse_iterator rend()
+        { return reverse_iterator(begin()); }
+
+        const_reverse_iterator rbegin() const
+        { return const_reverse_iterator(end()); }
+
+        const_reverse_iterator rend() const
+        { return const_reverse_iterator(begin()); }
+
+        size_t size() const
+        { return count; }
+
+        bool empty() const
+        { return 0 == count; }
+
+        void clear()
+        { count = 0; }
+
+        void push_back(const TilesAddon &);
+
         void Remove(uint32_t uniq);
+
+        /* move the range to the end of the new pool */
+        void Compact(vector<TilesAddon> &pool);
+
+    private:
+        uint32_t offset;
+        u16 count;
+        u16 capacity;
+    };
+
+    /* the addons of all tiles in one array */
+    struct AddonsPool
+    {
+        AddonsPool() : unused(0)
+        {}
+
+        void Clear();
+
+        vector<TilesAddon> items;
+        uint32_t unused;  // slots left behind by the grown ranges
+    };
+
+    /* the tile fields read by the whole map scans, one packed array per field, indexed by the tile index */
+    struct TilesHot
+    {
+        void Resize(size_t size);
+
+        void Clear();
+
+        vector<u8> objects;
+        vector<u16> passables;
+        vector<u8> fogs;
+        vector<u16> grounds; // from the tile sprite, not saved
+        vector<u16> roads;   // directions with a road, not saved
+    };
+
+    /* the sorted tile indexes of every object but OBJ_ZERO, follows Tiles::SetObject */
+    struct ObjectsIndex
+    {
+        void Clear();
+
+        void Rebuild(const vector<u8> &objects);
+
+        void Move(s32 index, int from, int to);
+
+        const MapsIndexes &Get(int obj) const
+        { return positions[obj & 0xFF]; }
+
+        MapsIndexes positions[0x100];
     };
 
     class Tiles
@@ -233,8 +327,7 @@ namespace Maps
 
         bool isRoad(int = DIRECTION_ALL) const;
 
-        bool isObject(int obj) const
-        { return obj == mp2_object; };
+        bool isObject(int obj) const;
 
         bool isStream() const;
 
@@ -256,6 +349,9 @@ namespace Maps
 
         void SetObject(int object);
 
+        int GetMonsterGuards() const
+        { return monster_guards; }
+
         void SetIndex(int);
 
         void FixObject();
@@ -372,7 +468,25 @@ namespace Maps
 
         static void FixedPreload(Tiles &);
 
+        static void UpdateMonsterGuards(vector<Tiles> &);
+
+        static void CompactAddons(vector<Tiles> &);
+
     private:
+        u8 &HotObject();
+
+        u8 HotObject() const;
+
+        u16 &HotPassable();
+
+        u16 HotPassable() const;
+
+        u8 &HotFogs();
+
+        u8 HotFogs() const;
+
+        void UpdateRoads();
+
         TilesAddon *FindFlags();
 
         void CorrectFlags32(uint32_t index, bool);
@@ -383,6 +497,8 @@ namespace Maps
 
         bool isLongObject(int direction);
 
+        void SetMonsterGuard(bool);
+
         void RedrawBoat(Surface &) const;
 
         void RedrawMonster(Surface &) const;
@@ -427,25 +543,26 @@ namespace Maps
         friend ByteVectorReader &operator>>(ByteVectorReader &, Tiles &);
 
         Addons addons_level1;
-        Addons addons_level2; // 16
+        Addons addons_level2;
 
         uint32_t maps_index;
         u16 pack_sprite_index;
 
-        u16 tile_passable;
-        u8 mp2_object;
-        u8 fog_colors;
+        // the object, passable and fog fields are kept in World::hot_tiles
 
         u8 quantity1;
         u8 quantity2;
         u8 quantity3;
 
+        u8 monster_guards; // directions to the neighbour monsters, not saved
     };
 
     ByteVectorWriter &operator<<(ByteVectorWriter&, const TilesAddon &);
+    ByteVectorWriter &operator<<(ByteVectorWriter&, const Addons &);
     ByteVectorWriter &operator<<(ByteVectorWriter&, const Tiles &);
     
     ByteVectorReader &operator>>(ByteVectorReader &, TilesAddon &);
+    ByteVectorReader &operator>>(ByteVectorReader &, Addons &);
     ByteVectorReader &operator>>(ByteVectorReader &, Tiles &);
 }
 
@@ -468,6 +468,8 @@ Troop Maps::Tiles::QuantityTroop() const
 
 void Maps::Tiles::QuantityReset()
 {
+    world.TileChanged(GetIndex());
+
     quantity1 = 0;
     quantity2 = 0;
 
@@ -489,7 +491,7 @@ void Maps::Tiles::QuantityReset()
             break;
     }
 
-    if (MP2::isPickupObject(mp2_object))
+    if (MP2::isPickupObject(HotObject()))
         SetObject(MP2::OBJ_ZERO);
 }
 
@@ -193,6 +193,7 @@ const settings_t settingsFHeroes2[] =
                 {Settings::BATTLE_MAGIC_TROOP_RESIST,        _("battle: magical creature resists (20%) the same magic"),},
                 {Settings::BATTLE_SKIP_INCREASE_DEFENSE,     _("battle: skip increase +2 defense"),},
                 {Settings::BATTLE_REVERSE_WAIT_ORDER,        _("battle: reverse wait order (fast, average, slow)"),},
+                {Settings::BATTLE_RECORD_REPLAYS,            _("battle: record replays to the save directory"),},
                 {Settings::GAME_SHOW_SYSTEM_INFO,            _("game: show system info"),},
                 {Settings::GAME_AUTOSAVE_ON,                 _("game: autosave on"),},
                 {Settings::GAME_AUTOSAVE_BEGIN_DAY,          _("game: autosave will be made at the beginning of the day"),},
@@ -229,7 +230,9 @@ Settings::Settings()
     font_normal("dejavusans.ttf"), font_small("dejavusans.ttf"), size_normal(15), size_small(10),
     sound_volume(6), music_volume(6), heroes_speed(DEFAULT_SPEED_DELAY),
     ai_speed(DEFAULT_SPEED_DELAY), scroll_speed(SCROLL_NORMAL), battle_speed(DEFAULT_SPEED_DELAY),
-    blit_speed(0), game_type(0), preferably_count_players(0), port(DEFAULT_PORT), memory_limit(0)
+    blit_speed(0), battle_ai_budget(0), battle_ai_threads(1), ai_threads(0), ai_estimate_budget(0),
+    headless(false),
+    game_type(0), preferably_count_players(0), port(DEFAULT_PORT), memory_limit(0)
 {
     ExtSetModes(GAME_SHOW_SDL_LOGO);
     ExtSetModes(GAME_AUTOSAVE_ON);
@@ -408,6 +411,23 @@ bool Settings::Read(const string &filename)
         if (10 < ai_speed) ai_speed = 10;
     }
 
+    // battle search
+    if (config.Exists("battle ai budget"))
+        battle_ai_budget = config.IntParams("battle ai budget");
+
+    if (config.Exists("battle ai threads"))
+        battle_ai_threads = config.IntParams("battle ai threads");
+
+    if (config.Exists("ai threads"))
+        ai_threads = config.IntParams("ai threads");
+
+    if (config.Exists("ai estimate budget"))
+        ai_estimate_budget = config.IntParams("ai estimate budget");
+
+    // AI turn profiles
+    sval = config.StrParams("ai profile");
+    if (!sval.empty()) ai_profile = sval;
+
     if (config.Exists("heroes speed"))
     {
         heroes_speed = config.IntParams("heroes speed");
@@ -570,6 +590,19 @@ string Settings::String() const
     if (opt_global.Modes(GLOBAL_POCKETPC))
         os << "pocket pc = on" << endl;
 
+    if (ai_threads)
+        os << "ai threads = " << ai_threads << endl;
+
+    if (ai_estimate_budget)
+        os << "ai estimate budget = " << ai_estimate_budget << endl;
+
+    if (!ai_profile.empty())
+        os << "ai profile = " << ai_profile << endl;
+
+    if (battle_ai_budget)
+        os << "battle ai budget = " << battle_ai_budget << endl <<
+           "battle ai threads = " << battle_ai_threads << endl;
+
     return os.str();
 }
 
@@ -789,6 +822,24 @@ int Settings::AIMoveSpeed() const
 int Settings::BattleSpeed() const
 { return battle_speed; }
 
+uint32_t Settings::BattleAIBudget() const
+{ return battle_ai_budget; }
+
+uint32_t Settings::BattleAIThreads() const
+{ return battle_ai_threads; }
+
+uint32_t Settings::AIThreads() const
+{ return ai_threads; }
+
+uint32_t Settings::AIEstimateBudget() const
+{ return ai_estimate_budget; }
+
+bool Settings::Headless() const
+{ return headless; }
+
+const string &Settings::AIProfile() const
+{ return ai_profile; }
+
 /* return scroll speed */
 int Settings::ScrollSpeed() const
 { return scroll_speed; }
@@ -805,6 +856,30 @@ void Settings::SetHeroesMoveSpeed(int speed)
 void Settings::SetBattleSpeed(int speed)
 { battle_speed = (10 <= speed ? 10 : speed); }
 
+/* set battle AI search: ms per turn, 0 - simple AI */
+void Settings::SetBattleAIBudget(uint32_t ms)
+{ battle_ai_budget = ms; }
+
+/* set battle AI search threads: 0 - one per core */
+void Settings::SetBattleAIThreads(uint32_t threads)
+{ battle_ai_threads = threads; }
+
+/* set adventure AI planning threads: 0 - one per core, 1 - no threads */
+void Settings::SetAIThreads(uint32_t threads)
+{ ai_threads = threads; }
+
+/* set battle estimate time limit: ms per estimate, 0 - the battle count only */
+void Settings::SetAIEstimateBudget(uint32_t ms)
+{ ai_estimate_budget = ms; }
+
+/* set headless mode: no display, sound and interface redraws */
+void Settings::SetHeadless(bool f)
+{ headless = f; }
+
+/* set AI turn profiles file: empty - off */
+void Settings::SetAIProfile(const string &file)
+{ ai_profile = file; }
+
 void Settings::SetBlitSpeed(int speed)
 { blit_speed = speed; }
 
@@ -1450,6 +1525,11 @@ bool Settings::ExtBattleReverseWaitOrder() const
     return ExtModes(BATTLE_REVERSE_WAIT_ORDER);
 }
 
+bool Settings::ExtBattleRecordReplays() const
+{
+    return ExtModes(BATTLE_RECORD_REPLAYS);
+}
+
 bool Settings::ExtWorldStartHeroLossCond4Humans() const
 {
     return ExtModes(WORLD_STARTHERO_LOSSCOND4HUMANS);
@@ -176,7 +176,7 @@ public:
 
         BATTLE_ARCHMAGE_RESIST_BAD_SPELL = 0x40001000,
         BATTLE_MAGIC_TROOP_RESIST = 0x40002000,
-        //UNUSED			= 0x40008000,
+        BATTLE_RECORD_REPLAYS = 0x40008000,
                 BATTLE_SOFT_WAITING = 0x40010000,
         BATTLE_REVERSE_WAIT_ORDER = 0x40020000,
         BATTLE_MERGE_ARMIES = 0x40100000,
@@ -205,6 +205,18 @@ public:
 
     int AIMoveSpeed() const;
 
+    uint32_t BattleAIBudget() const;
+
+    uint32_t BattleAIThreads() const;
+
+    uint32_t AIThreads() const;
+
+    uint32_t AIEstimateBudget() const;
+
+    bool Headless() const;
+
+    const string &AIProfile() const;
+
     int BattleSpeed() const;
 
     int ScrollSpeed() const;
@@ -404,6 +416,8 @@ public:
 
     bool ExtBattleReverseWaitOrder() const;
 
+    bool ExtBattleRecordReplays() const;
+
     bool ExtBattleShowGrid() const;
 
     bool ExtBattleShowMouseShadow() const;
@@ -478,6 +492,18 @@ public:
 
     void SetAIMoveSpeed(int);
 
+    void SetBattleAIBudget(uint32_t);
+
+    void SetBattleAIThreads(uint32_t);
+
+    void SetAIThreads(uint32_t);
+
+    void SetAIEstimateBudget(uint32_t);
+
+    void SetHeadless(bool);
+
+    void SetAIProfile(const string &);
+
     void SetScrollSpeed(int);
 
     void SetHeroesMoveSpeed(int);
@@ -629,6 +655,22 @@ private:
     int battle_speed;
     int blit_speed;
 
+    // search battle AI: ms per turn, 0 for the simple AI
+    uint32_t battle_ai_budget;
+    uint32_t battle_ai_threads;
+
+    // adventure AI planning threads, 0 for one per core
+    uint32_t ai_threads;
+
+    // adventure AI battle estimates: ms per estimate, 0 for a fixed battle count
+    uint32_t ai_estimate_budget;
+
+    // autoplay without display, sound and interface
+    bool headless;
+
+    // csv file of the AI turn profiles, empty: off
+    string ai_profile;
+
     int game_type;
     int preferably_count_players;
 